@@ -2411,6 +2411,10 @@ class ISAM2Params {
   void setEnableDetailedResults(bool enableDetailedResults);
   bool isEnablePartialRelinearizationCheck() const;
   void setEnablePartialRelinearizationCheck(bool enablePartialRelinearizationCheck);
+  bool isEnableCholeskyUpdate() const;
+  void setEnableCholeskyUpdate(bool enableCholeskyUpdate);
+  bool isEnableRecalculationCostModel() const;
+  void setEnableRecalculationCostModel(bool enableRecalculationCostModel);
 };
 
 class ISAM2Clique {
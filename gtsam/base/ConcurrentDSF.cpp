@@ -0,0 +1,108 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ConcurrentDSF.cpp
+ * @brief Lock-free disjoint set forest that supports concurrent merges
+ */
+
+#include <gtsam/base/ConcurrentDSF.h>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+ConcurrentDSF::ConcurrentDSF(size_t numNodes)
+    : size_(numNodes), parents_(new atomic<size_t>[numNodes]) {
+  for (size_t i = 0; i < numNodes; i++)
+    parents_[i].store(i, memory_order_relaxed);
+}
+
+/* ************************************************************************* */
+size_t ConcurrentDSF::find(size_t i) const {
+  // follow parent pointers, pointing every other node to its grandparent
+  while (true) {
+    size_t parent = parents_[i].load(memory_order_acquire);
+    if (parent == i) return i;
+    const size_t grandParent = parents_[parent].load(memory_order_acquire);
+    // if another thread changed i's parent in the meantime, that is fine too
+    if (grandParent != parent)
+      parents_[i].compare_exchange_weak(parent, grandParent,
+                                        memory_order_acq_rel);
+    i = grandParent;
+  }
+}
+
+/* ************************************************************************* */
+void ConcurrentDSF::merge(size_t i1, size_t i2) {
+  while (true) {
+    size_t root1 = find(i1), root2 = find(i2);
+    if (root1 == root2) return;
+
+    // Link the larger root below the smaller one. This fails if the larger
+    // root got linked by another thread after find, in which case we retry.
+    if (root1 < root2) swap(root1, root2);
+    size_t expected = root1;
+    if (parents_[root1].compare_exchange_strong(expected, root2,
+                                                memory_order_acq_rel))
+      return;
+    i1 = root1;
+    i2 = root2;
+  }
+}
+
+/* ************************************************************************* */
+void ConcurrentDSF::merge(const vector<Pair>& pairs) {
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, pairs.size()),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                      for (size_t k = range.begin(); k != range.end(); ++k)
+                        merge(pairs[k].first, pairs[k].second);
+                    });
+#else
+  for (const Pair& pair : pairs) merge(pair.first, pair.second);
+#endif
+}
+
+/* ************************************************************************* */
+vector<size_t> ConcurrentDSF::labels() const {
+  vector<size_t> labels(size_);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, size_),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                      for (size_t i = range.begin(); i != range.end(); ++i)
+                        labels[i] = find(i);
+                    });
+#else
+  for (size_t i = 0; i < size_; i++) labels[i] = find(i);
+#endif
+  return labels;
+}
+
+/* ************************************************************************* */
+vector<vector<size_t> > ConcurrentDSF::sets() const {
+  const vector<size_t> labels = this->labels();
+
+  // Representatives are the smallest elements, so they come first in order
+  vector<size_t> slots(size_);
+  vector<vector<size_t> > sets;
+  for (size_t i = 0; i < size_; i++) {
+    if (labels[i] == i) {
+      slots[i] = sets.size();
+      sets.push_back(vector<size_t>());
+    }
+    sets[slots[labels[i]]].push_back(i);
+  }
+  return sets;
+}
+
+}  // namespace gtsam
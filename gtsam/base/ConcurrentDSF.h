@@ -0,0 +1,158 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ConcurrentDSF.h
+ * @brief Lock-free disjoint set forest that supports concurrent merges
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+#include <gtsam/global_includes.h>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Disjoint set forest over the dense ids 0...numNodes-1, in which find() and
+ * merge() may be called from several threads at once.  Parent pointers are
+ * atomics: merge() links roots with a compare-and-swap and find() compresses
+ * paths by halving, so no locks are taken.  A root is always linked below the
+ * smaller of the two roots, hence the representative of a set is its smallest
+ * element, independently of the order in which merges happen.
+ * @addtogroup base
+ */
+class GTSAM_EXPORT ConcurrentDSF {
+ public:
+  typedef std::pair<size_t, size_t> Pair;
+
+ private:
+  size_t size_;
+  mutable std::unique_ptr<std::atomic<size_t>[]> parents_;
+
+ public:
+  /// Constructor, every element 0...numNodes-1 starts in its own set
+  explicit ConcurrentDSF(size_t numNodes);
+
+  /// Number of elements
+  size_t size() const { return size_; }
+
+  /// Find the representative, i.e., smallest element, of the set of i
+  size_t find(size_t i) const;
+
+  /// Merge the sets containing i1 and i2
+  void merge(size_t i1, size_t i2);
+
+  /// Merge the sets of all pairs, in parallel if TBB is enabled
+  void merge(const std::vector<Pair>& pairs);
+
+  /// The representative of every element, computed in parallel if TBB is enabled
+  std::vector<size_t> labels() const;
+
+  /**
+   * Return all sets, i.e. a partition of all elements.  The sets are ordered
+   * by their representative and their elements in increasing order.
+   */
+  std::vector<std::vector<size_t> > sets() const;
+};
+
+/**
+ * ConcurrentDSF for arbitrary keys, which are mapped to dense ids by their
+ * order.  All keys have to be given on construction, so that merge() can be
+ * called concurrently.  The representative of a set is its smallest key.
+ * @addtogroup base
+ */
+template <class KEY>
+class ConcurrentDSFMap {
+ private:
+  std::vector<KEY> keys_;  ///< sorted, the id of a key is its position
+  ConcurrentDSF dsf_;
+
+  static std::vector<KEY> SortedUnique(std::vector<KEY> keys) {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+  }
+
+ public:
+  typedef std::pair<KEY, KEY> Pair;
+
+  /// Constructor, keys may contain duplicates
+  explicit ConcurrentDSFMap(const std::vector<KEY>& keys)
+      : keys_(SortedUnique(keys)), dsf_(keys_.size()) {}
+
+  /// Number of keys
+  size_t size() const { return keys_.size(); }
+
+  /// The dense id of a key, throws std::out_of_range for unknown keys
+  size_t index(const KEY& key) const {
+    typename std::vector<KEY>::const_iterator it =
+        std::lower_bound(keys_.begin(), keys_.end(), key);
+    if (it == keys_.end() || key < *it)
+      throw std::out_of_range("ConcurrentDSFMap: unknown key");
+    return it - keys_.begin();
+  }
+
+  /// The key with a given dense id
+  const KEY& key(size_t i) const { return keys_[i]; }
+
+  /// Given key, find the representative key for the set in which it lives
+  KEY find(const KEY& key) const { return keys_[dsf_.find(index(key))]; }
+
+  /// Merge two sets
+  void merge(const KEY& x, const KEY& y) { dsf_.merge(index(x), index(y)); }
+
+  /// Merge the sets of all pairs, in parallel if TBB is enabled
+  void merge(const std::vector<Pair>& pairs) {
+    std::vector<ConcurrentDSF::Pair> indices(pairs.size());
+    auto convert = [&](size_t begin, size_t end) {
+      for (size_t k = begin; k < end; ++k)
+        indices[k] = ConcurrentDSF::Pair(index(pairs[k].first),
+                                         index(pairs[k].second));
+    };
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, pairs.size()),
+                      [&](const tbb::blocked_range<size_t>& range) {
+                        convert(range.begin(), range.end());
+                      });
+#else
+    convert(0, pairs.size());
+#endif
+    dsf_.merge(indices);
+  }
+
+  /// Return all sets, ordered by representative, keys in increasing order
+  std::vector<std::vector<KEY> > sets() const {
+    std::vector<std::vector<KEY> > sets;
+    const std::vector<std::vector<size_t> > ids = dsf_.sets();
+    sets.reserve(ids.size());
+    for (const std::vector<size_t>& set : ids) {
+      sets.push_back(std::vector<KEY>());
+      sets.back().reserve(set.size());
+      for (size_t i : set) sets.back().push_back(keys_[i]);
+    }
+    return sets;
+  }
+};
+
+}  // namespace gtsam
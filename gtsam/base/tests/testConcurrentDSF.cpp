@@ -0,0 +1,97 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testConcurrentDSF.cpp
+ * @brief unit tests for ConcurrentDSF and ConcurrentDSFMap
+ */
+
+#include <gtsam/base/ConcurrentDSF.h>
+#include <gtsam/base/DSFMap.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <random>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(ConcurrentDSF, merge) {
+  ConcurrentDSF dsf(5);
+  EXPECT(dsf.find(0) != dsf.find(1));
+  dsf.merge(3, 1);
+  dsf.merge(4, 3);
+  EXPECT_LONGS_EQUAL(1, dsf.find(4));
+  EXPECT_LONGS_EQUAL(1, dsf.find(3));
+  EXPECT_LONGS_EQUAL(0, dsf.find(0));
+  EXPECT_LONGS_EQUAL(2, dsf.find(2));
+
+  vector<vector<size_t> > expected = {{0}, {1, 3, 4}, {2}};
+  EXPECT(expected == dsf.sets());
+}
+
+/* ************************************************************************* */
+// Merging many pairs at once gives the same partition as DSFMap
+TEST(ConcurrentDSF, mergePairs) {
+  std::mt19937 rng;
+  std::uniform_int_distribution<size_t> rn(0, 999);
+  vector<ConcurrentDSF::Pair> pairs;
+  DSFMap<size_t> expected;
+  for (size_t k = 0; k < 600; k++) {
+    pairs.push_back(ConcurrentDSF::Pair(rn(rng), rn(rng)));
+    expected.merge(pairs.back().first, pairs.back().second);
+  }
+
+  ConcurrentDSF dsf(1000);
+  dsf.merge(pairs);
+  vector<size_t> labels = dsf.labels();
+  for (const ConcurrentDSF::Pair& pair : pairs) {
+    EXPECT_LONGS_EQUAL(labels[pair.first], labels[pair.second]);
+    EXPECT_LONGS_EQUAL(
+        *expected.sets()[expected.find(pair.first)].begin(), labels[pair.first]);
+  }
+
+  // Every element is in exactly one set
+  size_t count = 0;
+  for (const vector<size_t>& set : dsf.sets()) {
+    for (size_t i : set) EXPECT_LONGS_EQUAL(set.front(), labels[i]);
+    count += set.size();
+  }
+  EXPECT_LONGS_EQUAL(1000, count);
+}
+
+/* ************************************************************************* */
+TEST(ConcurrentDSFMap, sets) {
+  typedef pair<size_t, size_t> Feature;  // image, feature in image
+  vector<Feature> keys = {{2, 1}, {1, 5}, {0, 7}, {1, 5}, {2, 3}};
+  ConcurrentDSFMap<Feature> dsf(keys);
+  EXPECT_LONGS_EQUAL(4, dsf.size());
+  EXPECT_LONGS_EQUAL(1, dsf.index(Feature(1, 5)));
+  CHECK_EXCEPTION(dsf.index(Feature(3, 3)), std::out_of_range);
+
+  vector<ConcurrentDSFMap<Feature>::Pair> matches;
+  matches.push_back(make_pair(Feature(2, 1), Feature(1, 5)));
+  matches.push_back(make_pair(Feature(2, 3), Feature(0, 7)));
+  dsf.merge(matches);
+  EXPECT(dsf.find(Feature(2, 1)) == Feature(1, 5));
+  EXPECT(dsf.find(Feature(2, 3)) == Feature(0, 7));
+
+  vector<vector<Feature> > expected = {{{0, 7}, {2, 3}}, {{1, 5}, {2, 1}}};
+  EXPECT(expected == dsf.sets());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
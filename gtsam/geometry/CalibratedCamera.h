@@ -196,8 +196,19 @@ public:
    * @param point 3D point in world coordinates
    * @return the intrinsic coordinates of the projected point
    */
-  Point2 project2(const Point3& point, OptionalJacobian<2, 6> Dpose =
-      boost::none, OptionalJacobian<2, 3> Dpoint = boost::none) const;
+  Point2 project2(const Point3& point, OptionalJacobian<2, 6> Dpose,
+      OptionalJacobian<2, 3> Dpoint = boost::none) const;
+
+  /// Project point into the image, without derivatives
+  Point2 project2(const Point3& point) const {
+    const Point3 q = pose().transformTo(point);
+#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
+    if (q.z() <= 0)
+      throw CheiralityException();
+#endif
+    const double d = 1.0 / q.z();
+    return Point2(q.x() * d, q.y() * d);
+  }
 
   /** Project point at infinity into the image
    * Throws a CheiralityException if point behind image plane iff GTSAM_THROW_CHEIRALITY_EXCEPTION
@@ -240,11 +240,16 @@ public:
   }
 
   /// project a 3D point from world coordinates into the image
-  Point2 project2(const Point3& pw, OptionalJacobian<2, dimension> Dcamera =
-      boost::none, OptionalJacobian<2, 3> Dpoint = boost::none) const {
+  Point2 project2(const Point3& pw, OptionalJacobian<2, dimension> Dcamera,
+      OptionalJacobian<2, 3> Dpoint = boost::none) const {
     return _project2(pw, Dcamera, Dpoint);
   }
 
+  /// project a 3D point from world coordinates into the image, without derivatives
+  Point2 project2(const Point3& pw) const {
+    return Base::project(pw);
+  }
+
   /// project a point at infinity from world coordinates into the image
   Point2 project2(const Unit3& pw, OptionalJacobian<2, dimension> Dcamera =
       boost::none, OptionalJacobian<2, 2> Dpoint = boost::none) const {
@@ -115,12 +115,17 @@ public:
   }
 
   /// project a 3D point from world coordinates into the image
-  Point2 project(const Point3& pw, OptionalJacobian<2, 6> Dpose = boost::none,
+  Point2 project(const Point3& pw, OptionalJacobian<2, 6> Dpose,
       OptionalJacobian<2, 3> Dpoint = boost::none,
       OptionalJacobian<2, DimK> Dcal = boost::none) const {
     return _project(pw, Dpose, Dpoint, Dcal);
   }
 
+  /// project a 3D point from world coordinates into the image, without derivatives
+  Point2 project(const Point3& pw) const {
+    return calibration().uncalibrate(PinholeBase::project2(pw));
+  }
+
   /// project a point at infinity from world coordinates into the image
   Point2 project(const Unit3& pw, OptionalJacobian<2, 6> Dpose = boost::none,
       OptionalJacobian<2, 2> Dpoint = boost::none,
@@ -370,11 +375,16 @@ public:
    *  @param Dpose is the Jacobian w.r.t. the whole camera (really only the pose)
    *  @param Dpoint is the Jacobian w.r.t. point3
    */
-  Point2 project2(const Point3& pw, OptionalJacobian<2, 6> Dpose = boost::none,
+  Point2 project2(const Point3& pw, OptionalJacobian<2, 6> Dpose,
       OptionalJacobian<2, 3> Dpoint = boost::none) const {
     return Base::project(pw, Dpose, Dpoint);
   }
 
+  /// project a point from world coordinate to the image, without derivatives
+  Point2 project2(const Point3& pw) const {
+    return Base::project(pw);
+  }
+
   /// project2 version for point at infinity
   Point2 project2(const Unit3& pw, OptionalJacobian<2, 6> Dpose = boost::none,
       OptionalJacobian<2, 2> Dpoint = boost::none) const {
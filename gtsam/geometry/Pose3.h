@@ -206,8 +206,13 @@ public:
    * @param Dpoint optional 3*3 Jacobian wrpt point
    * @return point in world coordinates
    */
-  Point3 transformFrom(const Point3& p, OptionalJacobian<3, 6> Dpose =
-      boost::none, OptionalJacobian<3, 3> Dpoint = boost::none) const;
+  Point3 transformFrom(const Point3& p, OptionalJacobian<3, 6> Dpose,
+      OptionalJacobian<3, 3> Dpoint = boost::none) const;
+
+  /// transform point from Pose to world coordinates, without derivatives
+  Point3 transformFrom(const Point3& p) const {
+    return R_.rotate(p) + t_;
+  }
 
   /** syntactic sugar for transformFrom */
   inline Point3 operator*(const Point3& p) const {
@@ -221,8 +226,13 @@ public:
    * @param Dpoint optional 3*3 Jacobian wrpt point
    * @return point in Pose coordinates
    */
-  Point3 transformTo(const Point3& p, OptionalJacobian<3, 6> Dpose =
-      boost::none, OptionalJacobian<3, 3> Dpoint = boost::none) const;
+  Point3 transformTo(const Point3& p, OptionalJacobian<3, 6> Dpose,
+      OptionalJacobian<3, 3> Dpoint = boost::none) const;
+
+  /// transform point from world to Pose coordinates, without derivatives
+  Point3 transformTo(const Point3& p) const {
+    return R_.unrotate(p - t_);
+  }
 
   /// @}
   /// @name Standard Interface
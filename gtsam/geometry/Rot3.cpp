@@ -100,11 +100,6 @@ bool Rot3::equals(const Rot3 & R, double tol) const {
   return equal_with_abs_tol(matrix(), R.matrix(), tol);
 }
 
-/* ************************************************************************* */
-Point3 Rot3::operator*(const Point3& p) const {
-  return rotate(p);
-}
-
 /* ************************************************************************* */
 Unit3 Rot3::rotate(const Unit3& p,
     OptionalJacobian<2,3> HR, OptionalJacobian<2,2> Hp) const {
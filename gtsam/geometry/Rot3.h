@@ -269,7 +269,13 @@ namespace gtsam {
     }
 
     /// Syntatic sugar for composing two rotations
-    Rot3 operator*(const Rot3& R2) const;
+    Rot3 operator*(const Rot3& R2) const {
+#ifdef GTSAM_USE_QUATERNIONS
+      return Rot3(quaternion_ * R2.quaternion_);
+#else
+      return Rot3(rot_ * R2.rot_);
+#endif
+    }
 
     /// inverse of a rotation
     Rot3 inverse() const {
@@ -377,16 +383,36 @@ namespace gtsam {
     /**
      * rotate point from rotated coordinate frame to world \f$ p^w = R_c^w p^c \f$
      */
-    Point3 rotate(const Point3& p, OptionalJacobian<3,3> H1 = boost::none,
+    Point3 rotate(const Point3& p, OptionalJacobian<3,3> H1,
         OptionalJacobian<3,3> H2 = boost::none) const;
 
+    /// rotate point without derivatives, inlined so no Jacobian is tested for
+    Point3 rotate(const Point3& p) const {
+#ifdef GTSAM_USE_QUATERNIONS
+      return Point3(quaternion_ * Vector3(p));
+#else
+      return Point3(rot_.matrix() * p);
+#endif
+    }
+
     /// rotate point from rotated coordinate frame to world = R*p
-    Point3 operator*(const Point3& p) const;
+    Point3 operator*(const Point3& p) const {
+      return rotate(p);
+    }
 
     /// rotate point from world to rotated frame \f$ p^c = (R_c^w)^T p^w \f$
-    Point3 unrotate(const Point3& p, OptionalJacobian<3,3> H1 = boost::none,
+    Point3 unrotate(const Point3& p, OptionalJacobian<3,3> H1,
         OptionalJacobian<3,3> H2=boost::none) const;
 
+    /// unrotate point without derivatives, inlined so no Jacobian is tested for
+    Point3 unrotate(const Point3& p) const {
+#ifdef GTSAM_USE_QUATERNIONS
+      return Point3(quaternion_.conjugate() * Vector3(p));
+#else
+      return Point3(rot_.matrix().transpose() * p);
+#endif
+    }
+
     /// @}
     /// @name Group Action on Unit3
     /// @{
@@ -104,11 +104,6 @@ Rot3 Rot3::RzRyRx(double x, double y, double z) {
   );
 }
 
-/* ************************************************************************* */
-Rot3 Rot3::operator*(const Rot3& R2) const {
-  return Rot3(rot_*R2.rot_);
-}
-
 /* ************************************************************************* */
 Matrix3 Rot3::transpose() const {
   return rot_.matrix().transpose();
@@ -73,11 +73,6 @@ namespace gtsam {
       gtsam::Quaternion(Eigen::AngleAxisd(x, Eigen::Vector3d::UnitX())));
   }
 
-  /* ************************************************************************* */
-  Rot3 Rot3::operator*(const Rot3& R2) const {
-    return Rot3(quaternion_ * R2.quaternion_);
-  }
-
   /* ************************************************************************* */
   // TODO: Maybe use return type `const Eigen::Transpose<const Matrix3>`?
   // It works in Rot3M but not here, because of some weird behavior
@@ -273,6 +273,17 @@ Unit3 Unit3::retract(const Vector2& v, OptionalJacobian<2,2> H) const {
   return exp_p_xi_hat;
 }
 
+/* ************************************************************************* */
+Unit3 Unit3::retract(const Vector2& v) const {
+  // Same as above, without the Jacobian computations
+  const Vector3 xi_hat = basis() * v;
+  const double theta = xi_hat.norm();
+  const double c = std::cos(theta);
+  if (theta < std::numeric_limits<double>::epsilon())
+    return Unit3(c * p_ + xi_hat);
+  return Unit3(c * p_ + xi_hat * (std::sin(theta) / theta));
+}
+
 /* ************************************************************************* */
 Vector2 Unit3::localCoordinates(const Unit3& other) const {
   const double x = p_.dot(other.p_);
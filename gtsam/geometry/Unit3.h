@@ -193,7 +193,10 @@ public:
   };
 
   /// The retract function
-  GTSAM_EXPORT Unit3 retract(const Vector2& v, OptionalJacobian<2,2> H = boost::none) const;
+  GTSAM_EXPORT Unit3 retract(const Vector2& v, OptionalJacobian<2,2> H) const;
+
+  /// The retract function, without derivatives
+  GTSAM_EXPORT Unit3 retract(const Vector2& v) const;
 
   /// The local coordinates function
   GTSAM_EXPORT Vector2 localCoordinates(const Unit3& s) const;
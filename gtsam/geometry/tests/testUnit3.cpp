@@ -376,7 +376,7 @@ TEST (Unit3, jacobian_retract) {
   Matrix22 H;
   Unit3 p;
   boost::function<Unit3(const Vector2&)> f =
-      boost::bind(&Unit3::retract, p, _1, boost::none);
+      [p](const Vector2& v) { return p.retract(v); };
   {
       Vector2 v (-0.2, 0.1);
       p.retract(v, H);
@@ -469,9 +469,10 @@ namespace gtsam {
       }
     }
 
-    // Delete cachedShortcuts for each orphan subtree
-    // TODO(frank): Consider Improving
-    for (sharedClique& orphan : *orphans) orphan->deleteCachedShortcuts();
+    // Delete cached separator marginals for each orphan subtree, they depend on
+    // the removed top. Shortcuts to cliques within the orphan subtrees remain
+    // valid, and shortcuts to removed cliques can no longer be requested.
+    for (sharedClique& orphan : *orphans) orphan->deleteCachedSeparatorMarginals();
   }
 
   /* ************************************************************************* */
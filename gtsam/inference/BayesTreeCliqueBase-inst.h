@@ -104,13 +104,24 @@ namespace gtsam {
   /* ************************************************************************* */
   // The shortcut density is a conditional P(S|R) of the separator of this
   // clique on the root. We can compute it recursively from the parent shortcut
-  // P(Sp|R) as \int P(Fp|Sp) P(Sp|R), where Fp are the frontal nodes in p
+  // P(Sp|R) as \int P(Fp|Sp) P(Sp|R), where Fp are the frontal nodes in p.
+  // The result only depends on the cliques from this one up to B, and is cached
+  // for repeated joint queries below B. The cliques above B hold no cache then,
+  // so deleteCachedShortcuts visits the whole subtree.
   /* ************************************************************************* */
   template<class DERIVED, class FACTORGRAPH>
   typename BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::BayesNetType
     BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::shortcut(const derived_ptr& B, Eliminate function) const
   {
     gttic(BayesTreeCliqueBase_shortcut);
+    // Check if the shortcut was already calculated for B
+    if (cachedShortcut_ && cachedShortcutRoot_.lock() == B)
+      return *cachedShortcut_;
+
+    gttic(BayesTreeCliqueBase_shortcut_cachemiss);
+    cachedShortcut_ = BayesNetType();
+    cachedShortcutRoot_ = B;
+
     // We only calculate the shortcut when this clique is not B
     // and when the S\B is not empty
     KeyVector S_setminus_B = separator_setminus_B(B);
@@ -118,9 +129,11 @@ namespace gtsam {
     {
       // Obtain P(Cp||B) = P(Fp|Sp) * P(Sp||B) as a factor graph
       derived_ptr parent(parent_.lock());
+      gttoc(BayesTreeCliqueBase_shortcut_cachemiss); // Flatten recursion in timing outline
       gttoc(BayesTreeCliqueBase_shortcut);
       FactorGraphType p_Cp_B(parent->shortcut(B, function)); // P(Sp||B)
       gttic(BayesTreeCliqueBase_shortcut);
+      gttic(BayesTreeCliqueBase_shortcut_cachemiss);
       p_Cp_B += parent->conditional_; // P(Fp|Sp)
 
       // Determine the variables we want to keepSet, S union B
@@ -128,12 +141,11 @@ namespace gtsam {
 
       // Marginalize out everything except S union B
       boost::shared_ptr<FactorGraphType> p_S_B = p_Cp_B.marginal(keep, function);
-      return *p_S_B->eliminatePartialSequential(S_setminus_B, function).first;
-    }
-    else
-    {
-      return BayesNetType();
+      cachedShortcut_ = *p_S_B->eliminatePartialSequential(S_setminus_B, function).first;
     }
+
+    // return the shortcut P(S||B)
+    return *cachedShortcut_;
   }
 
   /* ************************************************************************* */
@@ -199,18 +211,28 @@ namespace gtsam {
   template<class DERIVED, class FACTORGRAPH>
   void BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::deleteCachedShortcuts() {
 
-    // When a shortcut is requested, all of the shortcuts between it and the
-    // root are also generated. So, if this clique's cached shortcut is set,
-    // recursively call over all child cliques. Otherwise, it is unnecessary.
+    // Separator marginals are cached from the root down, but a shortcut only on
+    // the cliques up to its B, which can be below cliques without any cache.
+    // So all child cliques are visited.
+    for(derived_ptr& child: children) {
+      child->deleteCachedShortcuts();
+    }
+
+    //Delete CachedShortcut for this clique
+    deleteCachedShortcutsNonRecursive();
+  }
+
+  /* ************************************************************************* */
+  template<class DERIVED, class FACTORGRAPH>
+  void BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::deleteCachedSeparatorMarginals() {
+    // Separator marginals are cached from the root down, so the subtree below a
+    // clique without one holds none either
     if (cachedSeparatorMarginal_) {
       for(derived_ptr& child: children) {
-        child->deleteCachedShortcuts();
+        child->deleteCachedSeparatorMarginals();
       }
-
-      //Delete CachedShortcut for this clique
       cachedSeparatorMarginal_ = boost::none;
     }
-
   }
 
 }
@@ -80,6 +80,10 @@ namespace gtsam {
     /// This stores the Cached separator margnal P(S)
     mutable boost::optional<FactorGraphType> cachedSeparatorMarginal_;
 
+    /// This stores the cached shortcut P(S||B), for the clique B in cachedShortcutRoot_
+    mutable boost::optional<BayesNetType> cachedShortcut_;
+    mutable derived_weak_ptr cachedShortcutRoot_;
+
   public:
     sharedConditional conditional_;
     derived_weak_ptr parent_;
@@ -128,7 +132,7 @@ namespace gtsam {
     /// @name Advanced Interface
     /// @{
 
-    /** return the conditional P(S|Root) on the separator given the root */
+    /** return the conditional P(S|Root) on the separator given the root, using shortcut caching */
     BayesNetType shortcut(const derived_ptr& root, Eliminate function = EliminationTraitsType::DefaultEliminate) const;
 
     /** return the marginal P(S) on the separator */
@@ -138,14 +142,27 @@ namespace gtsam {
     FactorGraphType marginal2(Eliminate function = EliminationTraitsType::DefaultEliminate) const;
 
     /**
-     * This deletes the cached shortcuts of all cliques (subtree) below this clique.
-     * This is performed when the bayes tree is modified.
+     * This deletes the cached shortcuts and separator marginals of all cliques (subtree) below
+     * this clique, visiting every clique of the subtree.  This is performed when the bayes tree
+     * is modified, and must be called on every clique whose conditional is changed in place.
      */
     void deleteCachedShortcuts();
 
+    /**
+     * This deletes the cached separator marginals of all cliques (subtree) below this clique, but
+     * keeps their cached shortcuts.  This is performed for subtrees that are moved to a new
+     * parent, as the shortcuts only depend on the unchanged cliques below the shortcut root.
+     */
+    void deleteCachedSeparatorMarginals();
+
     const boost::optional<FactorGraphType>& cachedSeparatorMarginal() const {
       return cachedSeparatorMarginal_; }
 
+    /** The cached shortcut, if any, and the clique it was computed for in cachedShortcutRoot() */
+    const boost::optional<BayesNetType>& cachedShortcut() const { return cachedShortcut_; }
+
+    derived_ptr cachedShortcutRoot() const { return cachedShortcutRoot_.lock(); }
+
     friend class BayesTree<DerivedType>;
 
   protected:
@@ -159,7 +176,11 @@ namespace gtsam {
     KeyVector shortcut_indices(const derived_ptr& B, const FactorGraphType& p_Cp_B) const;
 
     /** Non-recursive delete cached shortcuts and marginals - internal only. */
-    void deleteCachedShortcutsNonRecursive() { cachedSeparatorMarginal_ = boost::none; }
+    void deleteCachedShortcutsNonRecursive() {
+      cachedSeparatorMarginal_ = boost::none;
+      cachedShortcut_ = boost::none;
+      cachedShortcutRoot_.reset();
+    }
 
   private:
 
@@ -22,8 +22,32 @@
 #include <gtsam/inference/inferenceExceptions.h>
 #include <boost/tuple/tuple.hpp>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <unordered_set>
+
 namespace gtsam {
 
+  namespace internal {
+    /* ************************************************************************* */
+    // Lowest common ancestor of two cliques, or null if they are in different trees
+    template<class CLIQUE>
+    boost::shared_ptr<CLIQUE> lowestCommonAncestor(
+      const boost::shared_ptr<CLIQUE>& clique1, const boost::shared_ptr<CLIQUE>& clique2)
+    {
+      std::unordered_set<const CLIQUE*> path1;
+      for (boost::shared_ptr<CLIQUE> p = clique1; p; p = p->parent())
+        path1.insert(p.get());
+      for (boost::shared_ptr<CLIQUE> p = clique2; p; p = p->parent())
+        if (path1.count(p.get()))
+          return p;
+      return boost::shared_ptr<CLIQUE>();
+    }
+  }
+
   /* ************************************************************************* */
   template<class FACTORGRAPH>
   boost::shared_ptr<typename EliminateableFactorGraph<FACTORGRAPH>::BayesNetType>
@@ -345,6 +369,90 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  template<class FACTORGRAPH>
+  std::vector<boost::shared_ptr<typename EliminateableFactorGraph<FACTORGRAPH>::BayesTreeType> >
+    EliminateableFactorGraph<FACTORGRAPH>::marginalMultifrontalBayesTrees(
+    const std::vector<KeyVector>& variableSets,
+    const Eliminate& function, OptionalVariableIndex variableIndex) const
+  {
+    if(!variableIndex) {
+      // If no variable index is provided, compute one and call this function again
+      VariableIndex computedVariableIndex(asDerived());
+      return marginalMultifrontalBayesTrees(variableSets, function, computedVariableIndex);
+    } else {
+      gttic(marginalMultifrontalBayesTrees);
+      typedef typename BayesTreeType::sharedClique sharedClique;
+
+      // Eliminate all variables not in any of the sets once, and the union of the sets into a
+      // Bayes tree on which all marginals are computed
+      KeySet unionSet;
+      for(const KeyVector& variables: variableSets)
+        unionSet.insert(variables.begin(), variables.end());
+      const KeyVector unionKeys(unionSet.begin(), unionSet.end());
+      Ordering totalOrdering = Ordering::ColamdConstrainedLast(*variableIndex, unionKeys);
+      const size_t nVars = unionKeys.size();
+      Ordering marginalizationOrdering(totalOrdering.begin(), totalOrdering.end() - nVars);
+      Ordering marginalVarsOrdering(totalOrdering.end() - nVars, totalOrdering.end());
+      boost::shared_ptr<BayesTreeType> bayesTree;
+      boost::shared_ptr<FactorGraphType> factorGraph;
+      boost::tie(bayesTree,factorGraph) =
+        eliminatePartialMultifrontal(marginalizationOrdering, function, *variableIndex);
+      const boost::shared_ptr<BayesTreeType> jointTree =
+        factorGraph->eliminateMultifrontal(marginalVarsOrdering, function);
+
+      // For each set, find the lowest common ancestor of its cliques in each tree. The
+      // separator marginals of the ancestors are computed and cached here, top-down, so that the
+      // marginals below only read the cached values and can be computed in parallel.
+      std::vector<std::vector<sharedClique> > ancestors(variableSets.size());
+      for(size_t q = 0; q < variableSets.size(); ++q) {
+        for(const Key j: variableSets[q]) {
+          const sharedClique clique = jointTree->clique(j);
+          bool merged = false;
+          for(sharedClique& ancestor: ancestors[q]) {
+            if(sharedClique lca = internal::lowestCommonAncestor(ancestor, clique)) {
+              ancestor = lca;
+              merged = true;
+              break;
+            }
+          }
+          if(!merged)
+            ancestors[q].push_back(clique);
+        }
+        for(const sharedClique& ancestor: ancestors[q])
+          ancestor->separatorMarginal(function);
+      }
+
+      // The joint of the ancestor clique and the paths to it from the cliques containing the
+      // variables is the marginal of the ancestor times the conditionals on the paths
+      std::vector<boost::shared_ptr<BayesTreeType> > marginals(variableSets.size());
+      auto computeMarginal = [&](size_t q) {
+        FactorGraphType joint;
+        std::unordered_set<const typename BayesTreeType::Clique*> added;
+        for(const sharedClique& ancestor: ancestors[q]) {
+          joint += ancestor->marginal2(function);
+          added.insert(ancestor.get());
+        }
+        for(const Key j: variableSets[q])
+          for(sharedClique clique = jointTree->clique(j); added.insert(clique.get()).second;
+              clique = clique->parent())
+            joint += clique->conditional();
+        marginals[q] = joint.marginalMultifrontalBayesTree(variableSets[q], function);
+      };
+#ifdef GTSAM_USE_TBB
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, variableSets.size()),
+                        [&](const tbb::blocked_range<size_t>& range) {
+                          for(size_t q = range.begin(); q != range.end(); ++q)
+                            computeMarginal(q);
+                        });
+#else
+      for(size_t q = 0; q < variableSets.size(); ++q)
+        computeMarginal(q);
+#endif
+      return marginals;
+    }
+  }
+
   /* ************************************************************************* */
   template<class FACTORGRAPH>
   boost::shared_ptr<FACTORGRAPH>
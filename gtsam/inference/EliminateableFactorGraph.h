@@ -273,6 +273,21 @@ namespace gtsam {
       const Eliminate& function = EliminationTraitsType::DefaultEliminate,
       OptionalVariableIndex variableIndex = boost::none) const;
 
+    /** Compute the marginals of many sets of variables and return each as a Bayes tree.  All
+     *  variables not in any of the sets are eliminated only once, using constrained COLAMD, into a
+     *  Bayes tree on the union of the sets.  The marginal of each set is then computed from the
+     *  cliques containing its variables and their lowest common ancestor, in parallel if TBB is
+     *  enabled.
+     *  @param variableSets The sets of variables whose marginals to compute.
+     *  @param function Optional dense elimination function, if not provided the default will be
+     *         used.
+     *  @param variableIndex Optional pre-computed VariableIndex for the factor graph, if not
+     *         provided one will be computed. */
+    std::vector<boost::shared_ptr<BayesTreeType> > marginalMultifrontalBayesTrees(
+      const std::vector<KeyVector>& variableSets,
+      const Eliminate& function = EliminationTraitsType::DefaultEliminate,
+      OptionalVariableIndex variableIndex = boost::none) const;
+
     /** Compute the marginal factor graph of the requested variables. */
     boost::shared_ptr<FactorGraphType> marginal(
       const KeyVector& variables,
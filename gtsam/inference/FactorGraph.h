@@ -353,6 +353,11 @@ class FactorGraph {
    */
   void resize(size_t size) { factors_.resize(size); }
 
+  /** Release unused capacity, e.g. after shrinking the graph with resize()
+   * (works like FastVector::shrink_to_fit).
+   */
+  void shrink_to_fit() { factors_.shrink_to_fit(); }
+
   /** delete factor without re-arranging indexes by inserting a nullptr pointer
    */
   void remove(size_t i) { factors_[i].reset(); }
@@ -68,4 +68,22 @@ void VariableIndex::augmentExistingFactor(const FactorIndex factorIndex, const K
   gttoc(VariableIndex_augmentExistingFactor);
 }
 
+/* ************************************************************************* */
+void VariableIndex::renumberFactors(const FactorIndices& newIndices, size_t nFactors)
+{
+  gttic(VariableIndex_renumberFactors);
+
+  for(KeyMap::value_type& key_factors: index_) {
+    FactorIndices& factors = key_factors.second;
+    for(FactorIndex& index: factors) {
+      assert(index < newIndices.size());
+      index = newIndices[index];
+    }
+    factors.shrink_to_fit();
+  }
+  nFactors_ = nFactors;
+
+  gttoc(VariableIndex_renumberFactors);
+}
+
 }
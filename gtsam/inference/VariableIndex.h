@@ -152,6 +152,17 @@ class GTSAM_EXPORT VariableIndex {
   template<typename ITERATOR>
   void removeUnusedVariables(ITERATOR firstKey, ITERATOR lastKey);
 
+  /**
+   * Renumber the factors, e.g. after the null factors left behind by remove()
+   * were dropped from the factor graph. The relative order of the factors
+   * must be preserved, so the lists of factor indices stay sorted.
+   *
+   * @param newIndices The new index of each factor, indexed by its old index.
+   *        Only the entries of factors still in the VariableIndex are used.
+   * @param nFactors The number of factors after renumbering.
+   */
+  void renumberFactors(const FactorIndices& newIndices, size_t nFactors);
+
   /// Iterator to the first variable entry
   const_iterator begin() const { return index_.begin(); }
 
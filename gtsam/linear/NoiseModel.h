@@ -205,6 +205,8 @@ namespace gtsam {
       virtual Vector sigmas() const;
       virtual Vector whiten(const Vector& v) const;
       virtual Vector unwhiten(const Vector& v) const;
+      virtual void whitenInPlace(Vector& v) const;
+      virtual void whitenInPlace(Eigen::Block<Vector>& v) const;
 
       /**
        * Squared Mahalanobis distance v'*R'*R*v = <R*v,R*v>
@@ -719,6 +719,52 @@ TEST(NoiseModel, NonDiagonalGaussian)
   }
 }
 
+/* ************************************************************************* */
+TEST(NoiseModel, GaussianWhitenFixedSize)
+{
+  // Fixed-size kernels for some dimensions, dynamic products for others
+  for (int n = 1; n <= 9; n++) {
+    Matrix R = Matrix::Random(n, n);
+    R.diagonal().array() += 2 * n;
+    R.triangularView<Eigen::StrictlyLower>().setZero();
+    SharedGaussian gaussian = Gaussian::SqrtInformation(R, false);
+
+    const Matrix H = Matrix::Random(n, 7);
+    const Vector v = Vector::Random(n);
+    EXPECT(assert_equal(Matrix(R * H), gaussian->Whiten(H)));
+    EXPECT(assert_equal(Vector(R * v), gaussian->whiten(v)));
+
+    Matrix A = H;
+    gaussian->WhitenInPlace(A);
+    EXPECT(assert_equal(Matrix(R * H), A));
+
+    Matrix Ab = Matrix::Zero(n + 2, 9);
+    Ab.block(1, 2, n, 7) = H;
+    gaussian->WhitenInPlace(Ab.block(1, 2, n, 7));
+    EXPECT(assert_equal(Matrix(R * H), Matrix(Ab.block(1, 2, n, 7))));
+
+    Vector w = v;
+    gaussian->whitenInPlace(w);
+    EXPECT(assert_equal(Vector(R * v), w));
+  }
+
+  // A square root information matrix that is not upper-triangular, and
+  // derived classes that do not store R
+  SharedGaussian diagonal = Diagonal::Sigmas(Vector3(0.5, 0.1, 0.2));
+  Vector w = Vector3(1, 1, 1);
+  diagonal->whitenInPlace(w);
+  EXPECT(assert_equal(Vector(Vector3(2, 10, 5)), w));
+
+  Matrix3 R;
+  R << 6, 5, 4, 1, 3, 2, 0, 1, 1;
+  SharedGaussian gaussian = Gaussian::SqrtInformation(R);
+  const Matrix H = Matrix::Random(3, 4);
+  EXPECT(assert_equal(Matrix(R * H), gaussian->Whiten(H)));
+  Matrix A = H;
+  gaussian->WhitenInPlace(A);
+  EXPECT(assert_equal(Matrix(R * H), A));
+}
+
 /* ************************************************************************* */
 int main() {  TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
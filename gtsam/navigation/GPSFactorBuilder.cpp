@@ -0,0 +1,76 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   GPSFactorBuilder.cpp
+ *  @brief  Batched conversion of geodetic GPS fixes and bulk GPS factor creation
+ **/
+
+#include <gtsam/navigation/GPSFactorBuilder.h>
+
+#include <cmath>
+
+using namespace std;
+
+namespace gtsam {
+
+const double GeodeticFrame::kWGS84Radius = 6378137.0;
+const double GeodeticFrame::kWGS84Flattening = 1.0 / 298.257223563;
+
+namespace {
+const double kDegree = M_PI / 180.0;
+}
+
+//***************************************************************************
+GeodeticFrame::GeodeticFrame(double lat0, double lon0, double h0,
+                             Convention convention, double a, double f)
+    : a_(a), e2_(f * (2 - f)), convention_(convention) {
+  origin_ = geocentric(lat0, lon0, h0);
+
+  // East, north and up directions at the origin
+  const double sphi = sin(lat0 * kDegree), cphi = cos(lat0 * kDegree);
+  const double slam = sin(lon0 * kDegree), clam = cos(lon0 * kDegree);
+  const Vector3 east(-slam, clam, 0);
+  const Vector3 north(-sphi * clam, -sphi * slam, cphi);
+  const Vector3 up(cphi * clam, cphi * slam, sphi);
+  if (convention == ENU)
+    R_ << east.transpose(), north.transpose(), up.transpose();
+  else
+    R_ << north.transpose(), east.transpose(), -up.transpose();
+}
+
+//***************************************************************************
+Vector3 GeodeticFrame::geocentric(double lat, double lon, double h) const {
+  const double sphi = sin(lat * kDegree), cphi = cos(lat * kDegree);
+  const double slam = sin(lon * kDegree), clam = cos(lon * kDegree);
+  const double N = a_ / sqrt(1 - e2_ * sphi * sphi);  // prime vertical radius
+  return Vector3((N + h) * cphi * clam, (N + h) * cphi * slam,
+                 (N * (1 - e2_) + h) * sphi);
+}
+
+//***************************************************************************
+Matrix GeodeticFrame::forward(const Vector& lat, const Vector& lon,
+                              const Vector& h) const {
+  // Same as geocentric() above, on whole arrays
+  const Eigen::ArrayXd phi = lat.array() * kDegree, lam = lon.array() * kDegree;
+  const Eigen::ArrayXd sphi = phi.sin(), cphi = phi.cos();
+  const Eigen::ArrayXd N = a_ * (1 - e2_ * sphi.square()).rsqrt();
+  const Eigen::ArrayXd r = (N + h.array()) * cphi;
+
+  Matrix delta(3, lat.size());
+  delta.row(0) = (r * lam.cos() - origin_.x()).matrix().transpose();
+  delta.row(1) = (r * lam.sin() - origin_.y()).matrix().transpose();
+  delta.row(2) =
+      ((N * (1 - e2_) + h.array()) * sphi - origin_.z()).matrix().transpose();
+  return R_ * delta;
+}
+
+}  // namespace gtsam
@@ -0,0 +1,150 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   GPSFactorBuilder.h
+ *  @brief  Batched conversion of geodetic GPS fixes and bulk GPS factor creation
+ **/
+#pragma once
+
+#include <gtsam/navigation/GPSFactor.h>
+#include <gtsam/linear/NoiseModel.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A local Cartesian frame, ENU or NED, tangent to the WGS84 ellipsoid at a
+ * geodetic origin, as GeographicLib::LocalCartesian.  The conversion is closed
+ * form, via geocentric (ECEF) coordinates, and the batch version works on
+ * whole arrays of fixes at once so that Eigen can vectorize it.
+ * @addtogroup Navigation
+ */
+class GTSAM_EXPORT GeodeticFrame {
+ public:
+  enum Convention { ENU, NED };
+
+  /// WGS84 semi-major axis in meters and flattening
+  static const double kWGS84Radius, kWGS84Flattening;
+
+ private:
+  double a_, e2_;     ///< semi-major axis and squared eccentricity
+  Convention convention_;
+  Vector3 origin_;    ///< geocentric coordinates of the origin
+  Matrix3 R_;         ///< rows are the local axes in geocentric coordinates
+
+ public:
+  /**
+   * Constructor
+   * @param lat0 latitude of the origin in degrees
+   * @param lon0 longitude of the origin in degrees
+   * @param h0 height of the origin above the ellipsoid in meters
+   * @param convention whether local coordinates are ENU or NED
+   * @param a ellipsoid semi-major axis, defaults to WGS84
+   * @param f ellipsoid flattening, defaults to WGS84
+   */
+  GeodeticFrame(double lat0, double lon0, double h0, Convention convention = ENU,
+                double a = kWGS84Radius, double f = kWGS84Flattening);
+
+  /// Geocentric (ECEF) coordinates of a geodetic position in degrees and meters
+  Vector3 geocentric(double lat, double lon, double h) const;
+
+  /// Local coordinates of a single fix
+  Point3 forward(double lat, double lon, double h) const {
+    return Point3(R_ * (geocentric(lat, lon, h) - origin_));
+  }
+
+  /**
+   * Local coordinates of a batch of fixes, one per column of the result.
+   * @param lat latitudes in degrees
+   * @param lon longitudes in degrees
+   * @param h heights above the ellipsoid in meters
+   */
+  Matrix forward(const Vector& lat, const Vector& lon, const Vector& h) const;
+
+  Convention convention() const { return convention_; }
+};
+
+/**
+ * Creates GPS factors from geodetic fixes in bulk.  The local frame is chosen
+ * once, at construction, and all factors share the same noise model.  The
+ * factor type is a template argument, so that e.g. GPSFactor2 or
+ * BiasedGPSFactor from gtsam_unstable can be created as well.
+ * @addtogroup Navigation
+ */
+class GTSAM_EXPORT GPSFactorBuilder {
+  GeodeticFrame frame_;
+  SharedNoiseModel model_;
+
+ public:
+  /// Constructor from the local frame and the noise model shared by all factors
+  GPSFactorBuilder(const GeodeticFrame& frame, const SharedNoiseModel& model)
+      : frame_(frame), model_(model) {}
+
+  const GeodeticFrame& frame() const { return frame_; }
+  const SharedNoiseModel& noiseModel() const { return model_; }
+
+  /**
+   * Create a factor FACTOR(key, position, model) for each fix
+   * @param keys the variable for each fix
+   * @param lat latitudes in degrees
+   * @param lon longitudes in degrees
+   * @param h heights above the ellipsoid in meters
+   */
+  template <class FACTOR = GPSFactor>
+  std::vector<boost::shared_ptr<FACTOR> > create(const KeyVector& keys,
+                                                 const Vector& lat,
+                                                 const Vector& lon,
+                                                 const Vector& h) const {
+    const Matrix positions = forward(keys.size(), lat, lon, h);
+    std::vector<boost::shared_ptr<FACTOR> > factors;
+    factors.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
+      factors.push_back(
+          boost::make_shared<FACTOR>(keys[i], Point3(positions.col(i)), model_));
+    return factors;
+  }
+
+  /**
+   * Create a factor FACTOR(key, biasKey, position, model) for each fix, all
+   * sharing a single bias variable, as for BiasedGPSFactor
+   */
+  template <class FACTOR>
+  std::vector<boost::shared_ptr<FACTOR> > create(const KeyVector& keys,
+                                                 Key biasKey,
+                                                 const Vector& lat,
+                                                 const Vector& lon,
+                                                 const Vector& h) const {
+    const Matrix positions = forward(keys.size(), lat, lon, h);
+    std::vector<boost::shared_ptr<FACTOR> > factors;
+    factors.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
+      factors.push_back(boost::make_shared<FACTOR>(
+          keys[i], biasKey, Point3(positions.col(i)), model_));
+    return factors;
+  }
+
+ private:
+  /// Convert n fixes, checking that all arrays have n entries
+  Matrix forward(size_t n, const Vector& lat, const Vector& lon,
+                 const Vector& h) const {
+    if (size_t(lat.size()) != n || size_t(lon.size()) != n ||
+        size_t(h.size()) != n)
+      throw std::invalid_argument(
+          "GPSFactorBuilder::create: need one latitude, longitude and height "
+          "per key");
+    return frame_.forward(lat, lon, h);
+  }
+};
+
+}  // namespace gtsam
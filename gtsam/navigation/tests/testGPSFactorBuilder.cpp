@@ -0,0 +1,142 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testGPSFactorBuilder.cpp
+ * @brief   Unit test for GeodeticFrame and GPSFactorBuilder
+ */
+
+#include <gtsam/navigation/GPSFactorBuilder.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+// *************************************************************************
+namespace example {
+// Same as in testGPSFactor: ENU origin is where the plane was in hold next to
+// runway, and Dekalb-Peachtree Airport runway 2L
+const double lat0 = 33.86998, lon0 = -84.30626, h0 = 274;
+const double lat = 33.87071, lon = -84.30482, h = 274;
+
+// Stand-in for BiasedGPSFactor, which is in gtsam_unstable: a position fix
+// with a bias variable shared by all fixes
+class BiasedFix : public NoiseModelFactor2<Pose3, Point3> {
+  Point3 measured_;
+
+ public:
+  typedef boost::shared_ptr<BiasedFix> shared_ptr;
+  BiasedFix(Key poseKey, Key biasKey, const Point3& measured,
+            const SharedNoiseModel& model)
+      : NoiseModelFactor2<Pose3, Point3>(model, poseKey, biasKey),
+        measured_(measured) {}
+  const Point3& measured() const { return measured_; }
+  Vector evaluateError(const Pose3& pose, const Point3& bias,
+                       boost::optional<Matrix&> H1 = boost::none,
+                       boost::optional<Matrix&> H2 = boost::none) const {
+    return pose.translation(H1) + bias - measured_;
+  }
+};
+}
+
+// *************************************************************************
+TEST(GeodeticFrame, forward) {
+  using namespace example;
+  GeodeticFrame enu(lat0, lon0, h0);
+  Point3 actual = enu.forward(lat, lon, h);
+  EXPECT_DOUBLES_EQUAL(133.24, actual.x(), 1e-2);
+  EXPECT_DOUBLES_EQUAL(80.98, actual.y(), 1e-2);
+  EXPECT_DOUBLES_EQUAL(0, actual.z(), 1e-2);
+  EXPECT(assert_equal(Point3(0, 0, 0), enu.forward(lat0, lon0, h0), 1e-9));
+
+  // Height is along up
+  EXPECT(assert_equal(Point3(0, 0, 100), enu.forward(lat0, lon0, h0 + 100), 1e-6));
+
+  // NED axes
+  GeodeticFrame ned(lat0, lon0, h0, GeodeticFrame::NED);
+  EXPECT(assert_equal(Point3(actual.y(), actual.x(), -actual.z()),
+                      ned.forward(lat, lon, h), 1e-9));
+}
+
+// *************************************************************************
+TEST(GeodeticFrame, forwardBatch) {
+  using namespace example;
+  GeodeticFrame enu(lat0, lon0, h0);
+  Vector lats(4), lons(4), hs(4);
+  lats << lat0, lat, -33.9, 60.1;
+  lons << lon0, lon, 151.2, 24.9;
+  hs << h0, h, 10, -20;
+  Matrix actual = enu.forward(lats, lons, hs);
+  LONGS_EQUAL(3, actual.rows());
+  LONGS_EQUAL(4, actual.cols());
+  for (size_t i = 0; i < 4; i++)
+    EXPECT(assert_equal(enu.forward(lats(i), lons(i), hs(i)),
+                        Point3(actual.col(i)), 1e-6));
+}
+
+// *************************************************************************
+TEST(GPSFactorBuilder, create) {
+  using namespace example;
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(3, 0.25);
+  GPSFactorBuilder builder(GeodeticFrame(lat0, lon0, h0), model);
+
+  KeyVector keys = {1, 2};
+  Vector2 lats(lat0, lat), lons(lon0, lon), hs(h0, h);
+  vector<GPSFactor::shared_ptr> factors = builder.create(keys, lats, lons, hs);
+  LONGS_EQUAL(2, factors.size());
+  EXPECT(factors[0]->equals(GPSFactor(1, Point3(0, 0, 0), model), 1e-6));
+  EXPECT(factors[1]->equals(
+      GPSFactor(2, builder.frame().forward(lat, lon, h), model), 1e-6));
+  EXPECT(factors[0]->noiseModel() == factors[1]->noiseModel());
+
+  // NavState version
+  vector<GPSFactor2::shared_ptr> factors2 =
+      builder.create<GPSFactor2>(keys, lats, lons, hs);
+  EXPECT(factors2[0]->equals(GPSFactor2(1, Point3(0, 0, 0), model), 1e-6));
+
+  CHECK_EXCEPTION(builder.create(keys, Vector1(lat), lons, hs),
+                  std::invalid_argument);
+}
+
+// *************************************************************************
+TEST(GPSFactorBuilder, createBiased) {
+  using namespace example;
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(3, 0.25);
+  GPSFactorBuilder builder(GeodeticFrame(lat0, lon0, h0), model);
+
+  KeyVector keys = {1, 2};
+  const Key biasKey = 100;
+  Vector2 lats(lat0, lat), lons(lon0, lon), hs(h0, h);
+  vector<BiasedFix::shared_ptr> factors =
+      builder.create<BiasedFix>(keys, biasKey, lats, lons, hs);
+  LONGS_EQUAL(2, factors.size());
+  for (size_t i = 0; i < 2; i++) {
+    EXPECT(assert_container_equality(KeyVector({keys[i], biasKey}),
+                                     factors[i]->keys()));
+    EXPECT(factors[i]->noiseModel() == model);
+  }
+  EXPECT(assert_equal(Point3(0, 0, 0), factors[0]->measured(), 1e-6));
+  EXPECT(assert_equal(builder.frame().forward(lat, lon, h),
+                      factors[1]->measured(), 1e-9));
+
+  CHECK_EXCEPTION(builder.create<BiasedFix>(keys, biasKey, lats, lons,
+                                            Vector1(h)),
+                  std::invalid_argument);
+}
+
+// *************************************************************************
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+// *************************************************************************
@@ -25,8 +25,241 @@
 #include <boost/static_assert.hpp>
 #include <boost/type_traits/is_base_of.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+
 namespace gtsam {
 
+namespace internal {
+
+/// Thrown when the lanes of a LaneJet comparison disagree
+struct LaneDivergence : public std::exception {
+  const char* what() const noexcept override {
+    return "LaneJet: lanes take different branches";
+  }
+};
+
+/**
+ * A ceres-style Jet that carries K independent evaluations, one per SIMD
+ * lane: a holds the K values, and column j of v their derivatives with respect
+ * to the j-th input. All arithmetic is element-wise over the lanes, so Eigen
+ * vectorizes it across evaluations rather than across derivatives.
+ * Comparisons only make sense if all lanes agree, as the function then takes
+ * the same branch for all of them, otherwise LaneDivergence is thrown.
+ */
+template <int K, int N>
+struct LaneJet {
+  typedef Eigen::Array<double, K, 1> Lanes;
+  typedef Eigen::Array<double, K, N> Derivatives;
+
+  Lanes a;
+  Derivatives v;
+
+  LaneJet() : a(Lanes::Zero()), v(Derivatives::Zero()) {}
+
+  /// Constant, as in Jet the constructor is explicit
+  explicit LaneJet(double value)
+      : a(Lanes::Constant(value)), v(Derivatives::Zero()) {}
+
+  LaneJet(const Lanes& value, const Derivatives& derivatives)
+      : a(value), v(derivatives) {}
+
+  LaneJet& operator+=(const LaneJet& y) { return *this = *this + y; }
+  LaneJet& operator-=(const LaneJet& y) { return *this = *this - y; }
+  LaneJet& operator*=(const LaneJet& y) { return *this = *this * y; }
+  LaneJet& operator/=(const LaneJet& y) { return *this = *this / y; }
+  LaneJet& operator+=(double s) { return *this = *this + s; }
+  LaneJet& operator-=(double s) { return *this = *this - s; }
+  LaneJet& operator*=(double s) { return *this = *this * s; }
+  LaneJet& operator/=(double s) { return *this = *this / s; }
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// Reduce a lane-wise comparison to a single branch decision
+template <int K>
+bool AllLanes(const Eigen::Array<bool, K, 1>& mask) {
+  if (mask.all()) return true;
+  if (!mask.any()) return false;
+  throw LaneDivergence();
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator+(const LaneJet<K, N>& f) { return f; }
+
+template <int K, int N> inline
+LaneJet<K, N> operator-(const LaneJet<K, N>& f) {
+  return LaneJet<K, N>(-f.a, -f.v);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator+(const LaneJet<K, N>& f, const LaneJet<K, N>& g) {
+  return LaneJet<K, N>(f.a + g.a, f.v + g.v);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator-(const LaneJet<K, N>& f, const LaneJet<K, N>& g) {
+  return LaneJet<K, N>(f.a - g.a, f.v - g.v);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator*(const LaneJet<K, N>& f, const LaneJet<K, N>& g) {
+  return LaneJet<K, N>(f.a * g.a, f.v.colwise() * g.a + g.v.colwise() * f.a);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator/(const LaneJet<K, N>& f, const LaneJet<K, N>& g) {
+  // (f/g)' = (f' - (f/g) g') / g
+  const typename LaneJet<K, N>::Lanes inverse = g.a.inverse();
+  const typename LaneJet<K, N>::Lanes a = f.a * inverse;
+  return LaneJet<K, N>(a, (f.v - g.v.colwise() * a).colwise() * inverse);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator+(const LaneJet<K, N>& f, double s) {
+  return LaneJet<K, N>(f.a + s, f.v);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator+(double s, const LaneJet<K, N>& f) {
+  return LaneJet<K, N>(f.a + s, f.v);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator-(const LaneJet<K, N>& f, double s) {
+  return LaneJet<K, N>(f.a - s, f.v);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator-(double s, const LaneJet<K, N>& f) {
+  return LaneJet<K, N>(s - f.a, -f.v);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator*(const LaneJet<K, N>& f, double s) {
+  return LaneJet<K, N>(f.a * s, f.v * s);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator*(double s, const LaneJet<K, N>& f) {
+  return LaneJet<K, N>(f.a * s, f.v * s);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator/(const LaneJet<K, N>& f, double s) {
+  const double inverse = 1.0 / s;
+  return LaneJet<K, N>(f.a * inverse, f.v * inverse);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> operator/(double s, const LaneJet<K, N>& g) {
+  // (s/g)' = -s g' / g^2
+  const typename LaneJet<K, N>::Lanes inverse = g.a.inverse();
+  const typename LaneJet<K, N>::Lanes a = s * inverse;
+  return LaneJet<K, N>(a, g.v.colwise() * (-a * inverse));
+}
+
+#define GTSAM_LANEJET_COMPARISON(op)                                       \
+  template <int K, int N> inline                                           \
+  bool operator op(const LaneJet<K, N>& f, const LaneJet<K, N>& g) {       \
+    return AllLanes<K>(f.a op g.a);                                        \
+  }                                                                        \
+  template <int K, int N> inline                                           \
+  bool operator op(const LaneJet<K, N>& f, double s) {                     \
+    return AllLanes<K>(f.a op LaneJet<K, N>::Lanes::Constant(s));          \
+  }                                                                        \
+  template <int K, int N> inline                                           \
+  bool operator op(double s, const LaneJet<K, N>& g) {                     \
+    return AllLanes<K>(LaneJet<K, N>::Lanes::Constant(s) op g.a);          \
+  }
+GTSAM_LANEJET_COMPARISON(<)
+GTSAM_LANEJET_COMPARISON(<=)
+GTSAM_LANEJET_COMPARISON(>)
+GTSAM_LANEJET_COMPARISON(>=)
+GTSAM_LANEJET_COMPARISON(==)
+GTSAM_LANEJET_COMPARISON(!=)
+#undef GTSAM_LANEJET_COMPARISON
+
+// Elementary functions, found by argument dependent lookup from functors
+
+template <int K, int N> inline
+LaneJet<K, N> abs(const LaneJet<K, N>& f) {
+  return LaneJet<K, N>(f.a.abs(), f.v.colwise() * f.a.sign());
+}
+
+template <int K, int N> inline
+LaneJet<K, N> fabs(const LaneJet<K, N>& f) { return abs(f); }
+
+template <int K, int N> inline
+LaneJet<K, N> sqrt(const LaneJet<K, N>& f) {
+  const typename LaneJet<K, N>::Lanes a = f.a.sqrt();
+  return LaneJet<K, N>(a, f.v.colwise() * (0.5 * a.inverse()));
+}
+
+template <int K, int N> inline
+LaneJet<K, N> exp(const LaneJet<K, N>& f) {
+  const typename LaneJet<K, N>::Lanes a = f.a.exp();
+  return LaneJet<K, N>(a, f.v.colwise() * a);
+}
+
+template <int K, int N> inline
+LaneJet<K, N> log(const LaneJet<K, N>& f) {
+  return LaneJet<K, N>(f.a.log(), f.v.colwise() * f.a.inverse());
+}
+
+template <int K, int N> inline
+LaneJet<K, N> sin(const LaneJet<K, N>& f) {
+  return LaneJet<K, N>(f.a.sin(), f.v.colwise() * f.a.cos());
+}
+
+template <int K, int N> inline
+LaneJet<K, N> cos(const LaneJet<K, N>& f) {
+  return LaneJet<K, N>(f.a.cos(), f.v.colwise() * -f.a.sin());
+}
+
+template <int K, int N> inline
+LaneJet<K, N> tan(const LaneJet<K, N>& f) {
+  const typename LaneJet<K, N>::Lanes a = f.a.tan();
+  return LaneJet<K, N>(a, f.v.colwise() * (1.0 + a * a));
+}
+
+template <int K, int N> inline
+LaneJet<K, N> asin(const LaneJet<K, N>& f) {
+  return LaneJet<K, N>(f.a.asin(),
+                       f.v.colwise() * (1.0 - f.a * f.a).rsqrt());
+}
+
+template <int K, int N> inline
+LaneJet<K, N> acos(const LaneJet<K, N>& f) {
+  return LaneJet<K, N>(f.a.acos(),
+                       f.v.colwise() * -(1.0 - f.a * f.a).rsqrt());
+}
+
+template <int K, int N> inline
+LaneJet<K, N> atan(const LaneJet<K, N>& f) {
+  return LaneJet<K, N>(f.a.atan(),
+                       f.v.colwise() * (1.0 + f.a * f.a).inverse());
+}
+
+template <int K, int N> inline
+LaneJet<K, N> atan2(const LaneJet<K, N>& y, const LaneJet<K, N>& x) {
+  // atan2(y, x)' = (x y' - y x') / (x^2 + y^2)
+  typename LaneJet<K, N>::Lanes a;
+  for (int k = 0; k < K; ++k) a(k) = std::atan2(y.a(k), x.a(k));
+  const typename LaneJet<K, N>::Lanes inverse = (x.a * x.a + y.a * y.a).inverse();
+  return LaneJet<K, N>(a, y.v.colwise() * (x.a * inverse) -
+                              x.v.colwise() * (y.a * inverse));
+}
+
+template <int K, int N> inline
+LaneJet<K, N> pow(const LaneJet<K, N>& f, double g) {
+  return LaneJet<K, N>(f.a.pow(g), f.v.colwise() * (g * f.a.pow(g - 1.0)));
+}
+
+}  // namespace internal
+
 /**
  * The AdaptAutoDiff class uses ceres-style autodiff to adapt a ceres-style
  * Function evaluation, i.e., a function FUNCTOR that defines an operator
@@ -46,9 +279,12 @@ class AdaptAutoDiff {
   FUNCTOR f;
 
  public:
+  typedef Eigen::Matrix<double, M, N1> Jacobian1;
+  typedef Eigen::Matrix<double, M, N2> Jacobian2;
+
   VectorT operator()(const Vector1& v1, const Vector2& v2,
                      OptionalJacobian<M, N1> H1 = boost::none,
-                     OptionalJacobian<M, N2> H2 = boost::none) {
+                     OptionalJacobian<M, N2> H2 = boost::none) const {
     using ceres::internal::AutoDiff;
 
     bool success;
@@ -77,6 +313,75 @@ class AdaptAutoDiff {
           "AdaptAutoDiff: function call resulted in failure");
     return result;
   }
+
+  /**
+   * Evaluate at n points at once, K points at a time in the SIMD lanes of an
+   * internal::LaneJet, which amortizes the Jet setup and vectorizes the
+   * arithmetic across points. The last group is padded by repeating the
+   * last point. Groups for which the functor branches differently between
+   * points are evaluated one point at a time instead.
+   * @param v1, v2 arrays with the n arguments
+   * @param values array receiving the n function values
+   * @param H1, H2 optional arrays receiving the n Jacobians
+   */
+  template <int K = 4>
+  void evaluateBatch(size_t n, const Vector1* v1, const Vector2* v2,
+                     VectorT* values, Jacobian1* H1 = nullptr,
+                     Jacobian2* H2 = nullptr) const {
+    // Without derivatives, plain doubles are as fast as it gets
+    if (!H1 && !H2) {
+      for (size_t i = 0; i < n; ++i) values[i] = (*this)(v1[i], v2[i]);
+      return;
+    }
+
+    for (size_t i = 0; i < n; i += K) {
+      const size_t count = std::min<size_t>(K, n - i);
+      try {
+        evaluateLanes<K>(count, v1 + i, v2 + i, values + i, H1 ? H1 + i : nullptr,
+                         H2 ? H2 + i : nullptr);
+      } catch (const internal::LaneDivergence&) {
+        for (size_t j = i; j < i + count; ++j)
+          values[j] = (*this)(v1[j], v2[j],
+                              H1 ? OptionalJacobian<M, N1>(H1[j])
+                                 : OptionalJacobian<M, N1>(),
+                              H2 ? OptionalJacobian<M, N2>(H2[j])
+                                 : OptionalJacobian<M, N2>());
+      }
+    }
+  }
+
+ private:
+  /// Evaluate count <= K points in one LaneJet evaluation
+  template <int K>
+  void evaluateLanes(size_t count, const Vector1* v1, const Vector2* v2,
+                     VectorT* values, Jacobian1* H1, Jacobian2* H2) const {
+    typedef internal::LaneJet<K, N1 + N2> JetT;
+
+    // Seed the inputs, with unit derivatives with respect to themselves
+    JetT x1[N1], x2[N2], predicted[M];
+    for (int k = 0; k < K; ++k) {
+      const size_t i = std::min<size_t>(k, count - 1);
+      for (int j = 0; j < N1; ++j) x1[j].a(k) = v1[i](j);
+      for (int j = 0; j < N2; ++j) x2[j].a(k) = v2[i](j);
+    }
+    for (int j = 0; j < N1; ++j) x1[j].v.col(j).setOnes();
+    for (int j = 0; j < N2; ++j) x2[j].v.col(N1 + j).setOnes();
+
+    if (!f(x1, x2, predicted))
+      throw std::runtime_error(
+          "AdaptAutoDiff: function call resulted in failure");
+
+    // Scatter the lanes into the per-point results
+    for (size_t k = 0; k < count; ++k) {
+      for (int r = 0; r < M; ++r) {
+        values[k](r) = predicted[r].a(k);
+        if (H1)
+          for (int c = 0; c < N1; ++c) H1[k](r, c) = predicted[r].v(k, c);
+        if (H2)
+          for (int c = 0; c < N2; ++c) H2[k](r, c) = predicted[r].v(k, N1 + c);
+      }
+    }
+  }
 };
 
 }  // namespace gtsam
@@ -0,0 +1,198 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file AutoDiffFactorBatch.h
+ * @brief Batched linearization of factors with a common autodiff function
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/AdaptAutoDiff.h>
+#include <gtsam/nonlinear/ExpressionFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorBlock.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/NoiseModel.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A block of measurement factors that share a ceres-style FUNCTOR and a noise
+ * model, i.e., factor i has error FUNCTOR(x1_i, x2_i) - z_i, where x1_i and
+ * x2_i are vector-valued variables of dimension N1 and N2.  Instead of
+ * differentiating each factor separately, linearizeInto() evaluates all of
+ * them with AdaptAutoDiff::evaluateBatch, K factors at a time in SIMD lanes,
+ * and scatters the results into one JacobianFactor per measurement.  The
+ * result is the same as linearizing the equivalent ExpressionFactors.  As a
+ * NonlinearFactorBlock, the batch is one entry of a NonlinearFactorGraph, see
+ * there for how the optimizers use it.
+ */
+template <typename FUNCTOR, int M, int N1, int N2, int K = 4>
+class AutoDiffFactorBatch : public NonlinearFactorBlock {
+ public:
+  typedef AdaptAutoDiff<FUNCTOR, M, N1, N2> Adaptor;
+  typedef Eigen::Matrix<double, M, 1> Measurement;
+  typedef Eigen::Matrix<double, N1, 1> Vector1;
+  typedef Eigen::Matrix<double, N2, 1> Vector2;
+
+ private:
+  typedef AutoDiffFactorBatch<FUNCTOR, M, N1, N2, K> This;
+  typedef NonlinearFactorBlock Base;
+
+  Adaptor f_;
+  SharedNoiseModel model_;
+  std::vector<size_t> slots1_, slots2_;  ///< Positions of the member keys in keys()
+  std::vector<Measurement, Eigen::aligned_allocator<Measurement> > measured_;
+
+  typedef std::vector<Vector1, Eigen::aligned_allocator<Vector1> > Arguments1;
+  typedef std::vector<Vector2, Eigen::aligned_allocator<Vector2> > Arguments2;
+  typedef std::vector<Measurement, Eigen::aligned_allocator<Measurement> >
+      Predictions;
+
+  /// Gather the arguments of all factors from values
+  void arguments(const Values& values, Arguments1* v1, Arguments2* v2) const {
+    v1->resize(nrFactors());
+    v2->resize(nrFactors());
+    for (size_t i = 0; i < nrFactors(); ++i) {
+      (*v1)[i] = values.at<Vector1>(key1(i));
+      (*v2)[i] = values.at<Vector2>(key2(i));
+    }
+  }
+
+ public:
+  typedef boost::shared_ptr<This> shared_ptr;
+
+  /// Construct an empty batch, all factors will share the given noise model
+  explicit AutoDiffFactorBatch(const SharedNoiseModel& model) : model_(model) {
+    if (model_ && model_->dim() != M)
+      throw std::invalid_argument(
+          "AutoDiffFactorBatch: noise model dimension does not match");
+  }
+
+  virtual ~AutoDiffFactorBatch() {}
+
+  /// @return a deep copy of this factor
+  virtual NonlinearFactor::shared_ptr clone() const {
+    return boost::make_shared<This>(*this);
+  }
+
+  /// Add a factor with measurement z on variables key1 and key2
+  void add(Key key1, Key key2, const Measurement& z) {
+    slots1_.push_back(slot(key1));
+    slots2_.push_back(slot(key2));
+    measured_.push_back(z);
+  }
+
+  /// Number of factors in the batch
+  virtual size_t nrFactors() const { return measured_.size(); }
+
+  /// First key of factor i
+  Key key1(size_t i) const { return keys_[slots1_[i]]; }
+
+  /// Second key of factor i
+  Key key2(size_t i) const { return keys_[slots2_[i]]; }
+
+  /// Keys of factor i
+  virtual KeyVector factorKeys(size_t i) const {
+    return KeyVector{key1(i), key2(i)};
+  }
+
+  /// Number of rows on linearization, summed over all factors
+  virtual size_t dim() const { return M * nrFactors(); }
+
+  /// print
+  virtual void print(const std::string& s = "",
+                     const KeyFormatter& keyFormatter = DefaultKeyFormatter) const {
+    std::cout << s << "AutoDiffFactorBatch with " << nrFactors() << " factors\n";
+    for (size_t i = 0; i < nrFactors(); ++i)
+      std::cout << "  (" << keyFormatter(key1(i)) << "," << keyFormatter(key2(i))
+                << ") measured: " << measured_[i].transpose() << "\n";
+    if (model_) model_->print("  noise model: ");
+  }
+
+  /// equals
+  virtual bool equals(const NonlinearFactor& expected, double tol = 1e-9) const {
+    const This* e = dynamic_cast<const This*>(&expected);
+    if (e == nullptr || !Base::equals(*e, tol) || slots1_ != e->slots1_ ||
+        slots2_ != e->slots2_ || bool(model_) != bool(e->model_) ||
+        (model_ && !model_->equals(*e->model_, tol)))
+      return false;
+    for (size_t i = 0; i < nrFactors(); ++i)
+      if (!equal_with_abs_tol(measured_[i], e->measured_[i], tol)) return false;
+    return true;
+  }
+
+  /// The equivalent ExpressionFactors, e.g., to compare with
+  NonlinearFactorGraph expressionFactors() const {
+    NonlinearFactorGraph graph;
+    graph.reserve(nrFactors());
+    for (size_t i = 0; i < nrFactors(); ++i)
+      graph.addExpressionFactor(
+          model_, measured_[i],
+          Expression<Measurement>(f_, Expression<Vector1>(key1(i)),
+                                  Expression<Vector2>(key2(i))));
+    return graph;
+  }
+
+  /// Sum of the errors of all factors
+  virtual double error(const Values& values) const {
+    Arguments1 v1;
+    Arguments2 v2;
+    arguments(values, &v1, &v2);
+    Predictions predicted(nrFactors());
+    f_.template evaluateBatch<K>(nrFactors(), v1.data(), v2.data(),
+                                 predicted.data());
+
+    double total = 0.0;
+    for (size_t i = 0; i < nrFactors(); ++i) {
+      const Vector b = predicted[i] - measured_[i];
+      total += 0.5 * (model_ ? model_->distance(b) : b.squaredNorm());
+    }
+    return total;
+  }
+
+  /// Linearize all factors into graph[start], ..., one JacobianFactor each
+  virtual void linearizeInto(const Values& values, GaussianFactorGraph& graph,
+                             size_t start) const {
+    Arguments1 v1;
+    Arguments2 v2;
+    arguments(values, &v1, &v2);
+    Predictions predicted(nrFactors());
+    std::vector<typename Adaptor::Jacobian1,
+                Eigen::aligned_allocator<typename Adaptor::Jacobian1> > H1(nrFactors());
+    std::vector<typename Adaptor::Jacobian2,
+                Eigen::aligned_allocator<typename Adaptor::Jacobian2> > H2(nrFactors());
+    f_.template evaluateBatch<K>(nrFactors(), v1.data(), v2.data(),
+                                 predicted.data(), H1.data(), H2.data());
+
+    // Same whitened system as NoiseModelFactor::linearize
+    using noiseModel::Constrained;
+    const bool constrained = model_ && model_->isConstrained();
+    for (size_t i = 0; i < nrFactors(); ++i) {
+      Matrix A1 = H1[i], A2 = H2[i];
+      Vector b = measured_[i] - predicted[i];
+      if (model_) model_->WhitenSystem(A1, A2, b);
+      if (constrained)
+        graph[start + i] = boost::make_shared<JacobianFactor>(
+            key1(i), A1, key2(i), A2, b,
+            boost::static_pointer_cast<Constrained>(model_)->unit());
+      else
+        graph[start + i] =
+            boost::make_shared<JacobianFactor>(key1(i), A1, key2(i), A2, b);
+    }
+  }
+};
+
+}  // namespace gtsam
@@ -80,11 +80,26 @@ double DoglegOptimizer::getDelta() const {
   return static_cast<const State*>(state_.get())->delta;
 }
 
+/* ************************************************************************* */
+namespace {
+/// The steepest descent and Gauss-Newton points only share the factorization
+template <class BAYES>
+void ComputeCauchyAndNewtonPoints(const BAYES& Rd, VectorValues& dx_u, VectorValues& dx_n) {
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_invoke([&]() { dx_u = Rd.optimizeGradientSearch(); },
+                       [&]() { dx_n = Rd.optimize(); });
+#else
+  dx_u = Rd.optimizeGradientSearch();
+  dx_n = Rd.optimize();
+#endif
+}
+}  // namespace
+
 /* ************************************************************************* */
 GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
 
   // Linearize graph
-  GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_->values);
+  GaussianFactorGraph::shared_ptr linear = graph_.linearizeExpanded(state_->values);
 
   // Pull out parameters we'll use
   const bool dlVerbose = (params_.verbosityDL > DoglegParams::SILENT);
@@ -94,15 +109,15 @@ GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
 
   if ( params_.isMultifrontal() ) {
     GaussianBayesTree bt = *linear->eliminateMultifrontal(*params_.ordering, params_.getEliminationFunction());
-    VectorValues dx_u = bt.optimizeGradientSearch();
-    VectorValues dx_n = bt.optimize();
+    VectorValues dx_u, dx_n;
+    ComputeCauchyAndNewtonPoints(bt, dx_u, dx_n);
     result = DoglegOptimizerImpl::Iterate(getDelta(), DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
       dx_u, dx_n, bt, graph_, state_->values, state_->error, dlVerbose);
   }
   else if ( params_.isSequential() ) {
     GaussianBayesNet bn = *linear->eliminateSequential(*params_.ordering, params_.getEliminationFunction());
-    VectorValues dx_u = bn.optimizeGradientSearch();
-    VectorValues dx_n = bn.optimize();
+    VectorValues dx_u, dx_n;
+    ComputeCauchyAndNewtonPoints(bn, dx_u, dx_n);
     result = DoglegOptimizerImpl::Iterate(getDelta(), DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
       dx_u, dx_n, bn, graph_, state_->values, state_->error, dlVerbose);
   }
@@ -125,7 +140,7 @@ GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
 /* ************************************************************************* */
 DoglegParams DoglegOptimizer::ensureHasOrdering(DoglegParams params, const NonlinearFactorGraph& graph) const {
   if (!params.ordering)
-    params.ordering = Ordering::Create(params.orderingType, graph);
+    params.ordering = graph.ordering(params.orderingType);
   return params;
 }
 
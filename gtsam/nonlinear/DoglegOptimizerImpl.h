@@ -20,6 +20,11 @@
 
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_invoke.h>
+#endif
 
 namespace gtsam {
 
@@ -37,6 +42,17 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
     double f_error;
   };
 
+  /** A dogleg step for one trust region radius, together with the nonlinear
+   * error \f$ f(x_0 \oplus \delta x_d) \f$ and the model error
+   * \f$ M(\delta x_d) \f$ it results in.
+   */
+  struct GTSAM_EXPORT TrialStep {
+    double delta;
+    VectorValues dx_d;
+    double f_error;
+    double M_error;
+  };
+
   /** Specifies how the trust region is adapted at each Dogleg iteration.  If
    * this is SEARCH_EACH_ITERATION, then the trust region radius will be
    * increased potentially multiple times during one iteration until increasing
@@ -90,6 +106,12 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
    * @param f_error The result of <tt>f.error(x0)</tt>.
    * @return A DoglegIterationResult containing the new \c delta, the linear
    * update \c dx_d, and the resulting nonlinear error \c f_error.
+   *
+   * The factorization \c Rd, \c dx_u and \c dx_n are re-used for all trust
+   * region radii tried.  With TBB, the nonlinear and model errors of a step
+   * are evaluated concurrently.  The radii themselves are tried one at a time,
+   * as factors may cache intermediate results (e.g. smart factors), so \c f
+   * is never evaluated from two threads at once.
    */
   template<class M, class F, class VALUES>
   static IterationResult Iterate(
@@ -130,8 +152,56 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
    * @param x_n Newton's method minimizer
    */
   static VectorValues ComputeBlend(double delta, const VectorValues& x_u, const VectorValues& x_n, const bool verbose=false);
+
+  /**
+   * Compute the dogleg point for trust region radius \f$ \delta \f$ and
+   * evaluate both the nonlinear error \c f and the model error \c Rd there.
+   * See Iterate for the meaning of the arguments.
+   */
+  template<class M, class F, class VALUES>
+  static TrialStep EvaluateStep(double delta, const VectorValues& dx_u, const VectorValues& dx_n,
+      const M& Rd, const F& f, const VALUES& x0, const bool verbose=false);
 };
 
+/* ************************************************************************* */
+template<class M, class F, class VALUES>
+typename DoglegOptimizerImpl::TrialStep DoglegOptimizerImpl::EvaluateStep(
+    double delta, const VectorValues& dx_u, const VectorValues& dx_n,
+    const M& Rd, const F& f, const VALUES& x0, const bool verbose)
+{
+  TrialStep step;
+  step.delta = delta;
+
+  gttic(Dog_leg_point);
+  // Compute dog leg point
+  step.dx_d = ComputeDoglegPoint(delta, dx_u, dx_n, verbose);
+  gttoc(Dog_leg_point);
+
+#ifdef GTSAM_USE_TBB
+  // The decrease in f and in M do not depend on each other
+  tbb::parallel_invoke(
+      [&]() { step.f_error = f.error(x0.retract(step.dx_d)); },
+      [&]() { step.M_error = Rd.error(step.dx_d); });
+#else
+  gttic(retract);
+  // Compute expmapped solution
+  const VALUES x_d(x0.retract(step.dx_d));
+  gttoc(retract);
+
+  gttic(decrease_in_f);
+  // Compute decrease in f
+  step.f_error = f.error(x_d);
+  gttoc(decrease_in_f);
+
+  gttic(new_M_error);
+  // Compute decrease in M
+  step.M_error = Rd.error(step.dx_d);
+  gttoc(new_M_error);
+#endif
+
+  return step;
+}
+
 
 /* ************************************************************************* */
 template<class M, class F, class VALUES>
@@ -149,28 +219,13 @@ typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
   bool stay = true;
   enum { NONE, INCREASED_DELTA, DECREASED_DELTA } lastAction = NONE; // Used to prevent alternating between increasing and decreasing in one iteration
   while(stay) {
-    gttic(Dog_leg_point);
-    // Compute dog leg point
-    result.dx_d = ComputeDoglegPoint(delta, dx_u, dx_n, verbose);
-    gttoc(Dog_leg_point);
+    const TrialStep step = EvaluateStep(delta, dx_u, dx_n, Rd, f, x0, verbose);
+    result.dx_d = step.dx_d;
+    result.f_error = step.f_error;
+    const double new_M_error = step.M_error;
 
     if(verbose) std::cout << "delta = " << delta << ", dx_d_norm = " << result.dx_d.norm() << std::endl;
 
-    gttic(retract);
-    // Compute expmapped solution
-    const VALUES x_d(x0.retract(result.dx_d));
-    gttoc(retract);
-
-    gttic(decrease_in_f);
-    // Compute decrease in f
-    result.f_error = f.error(x_d);
-    gttoc(decrease_in_f);
-
-    gttic(new_M_error);
-    // Compute decrease in M
-    const double new_M_error = Rd.error(result.dx_d);
-    gttoc(new_M_error);
-
     if(verbose) std::cout << std::setprecision(15) << "f error: " << f_error << " -> " << result.f_error << std::endl;
     if(verbose) std::cout << std::setprecision(15) << "M error: " << M_error << " -> " << new_M_error << std::endl;
 
@@ -46,7 +46,7 @@ GaussianFactorGraph::shared_ptr GaussNewtonOptimizer::iterate() {
 
   // Linearize graph
   gttic(GaussNewtonOptimizer_Linearize);
-  GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_->values);
+  GaussianFactorGraph::shared_ptr linear = graph_.linearizeExpanded(state_->values);
   gttoc(GaussNewtonOptimizer_Linearize);
 
   // Solve Factor Graph
@@ -69,7 +69,7 @@ GaussianFactorGraph::shared_ptr GaussNewtonOptimizer::iterate() {
 GaussNewtonParams GaussNewtonOptimizer::ensureHasOrdering(
     GaussNewtonParams params, const NonlinearFactorGraph& graph) const {
   if (!params.ordering)
-    params.ordering = Ordering::Create(params.orderingType, graph);
+    params.ordering = graph.ordering(params.orderingType);
   return params;
 }
 
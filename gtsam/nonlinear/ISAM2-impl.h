@@ -82,12 +82,15 @@ struct GTSAM_EXPORT DeltaImpl {
   };
 
   /**
-   * Update the Newton's method step point, using wildfire
+   * Update the Newton's method step point, using wildfire.  If given,
+   * changedKeys is extended by the variables the wildfire changed, it is left
+   * alone when a wildfireThreshold of zero or less recalculates all of them.
    */
   static size_t UpdateGaussNewtonDelta(const ISAM2::Roots& roots,
                                        const KeySet& replacedKeys,
                                        double wildfireThreshold,
-                                       VectorValues* delta);
+                                       VectorValues* delta,
+                                       KeySet* changedKeys = nullptr);
 
   /**
    * Update the RgProd (R*g) incrementally taking into account which variables
@@ -139,7 +142,8 @@ struct GTSAM_EXPORT UpdateImpl {
   bool relinarizationNeeded(size_t update_count) const {
     return updateParams_.force_relinearize ||
            (params_.enableRelinearization &&
-            update_count % params_.relinearizeSkip == 0);
+            (updateParams_.batchIngestion ||
+             update_count % params_.relinearizeSkip == 0));
   }
 
   // Add any new factors \Factors:=\Factors\cup\Factors'.
@@ -383,8 +387,8 @@ struct GTSAM_EXPORT UpdateImpl {
             ? CheckRelinearizationPartial(roots, delta,
                                           params_.relinearizeThreshold)
             : CheckRelinearizationFull(delta, params_.relinearizeThreshold);
-    if (updateParams_.forceFullSolve)
-      relinKeys = CheckRelinearizationFull(delta, 0.0);  // for debugging
+    if (updateParams_.forceFullSolve || updateParams_.batchIngestion)
+      relinKeys = CheckRelinearizationFull(delta, 0.0);
 
     // Remove from relinKeys any keys whose linearization points are fixed
     for (Key key : fixedVariables) {
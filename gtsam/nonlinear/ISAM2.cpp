@@ -25,7 +25,14 @@
 #include <gtsam/inference/BayesTree-inst.h>
 #include <gtsam/nonlinear/LinearContainerFactor.h>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <map>
 #include <utility>
 
@@ -37,14 +44,19 @@ namespace gtsam {
 template class BayesTree<ISAM2Clique>;
 
 /* ************************************************************************* */
-ISAM2::ISAM2(const ISAM2Params& params) : params_(params), update_count_(0) {
+ISAM2::ISAM2(const ISAM2Params& params)
+    : allEstimatesOutdated_(false),
+      params_(params),
+      update_count_(0) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
 }
 
 /* ************************************************************************* */
-ISAM2::ISAM2() : update_count_(0) {
+ISAM2::ISAM2()
+    : allEstimatesOutdated_(false),
+      update_count_(0) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
@@ -150,12 +162,41 @@ void ISAM2::recalculate(const ISAM2UpdateParams& updateParams,
 
     KeySet affectedKeysSet;
     static const double kBatchThreshold = 0.65;
-    if (affectedKeys.size() >= theta_.size() * kBatchThreshold) {
+    const bool forceBatch = updateParams.batchIngestion;
+    bool batch =
+        forceBatch || affectedKeys.size() >= theta_.size() * kBatchThreshold;
+
+    // Amount of work for either strategy: factor-variable entries to
+    // eliminate, plus subtrees to reattach for an incremental step
+    double batchWork = 0.0, incrementalWork = 0.0;
+    if (params_.enableRecalculationCostModel) {
+      batchWork = variableIndex_.nEntries();
+      for (Key key : affectedKeys) incrementalWork += variableIndex_[key].size();
+      for (Key key : result->observedKeys)
+        incrementalWork += variableIndex_[key].size();
+      incrementalWork += orphans.size();
+      // Once both strategies were measured, choose the one predicted cheaper
+      if (!forceBatch && costModel_.calibrated())
+        batch = costModel_.chooseBatch(batchWork, incrementalWork, result);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (batch) {
       // Do a batch step - reorder and relinearize all variables
       recalculateBatch(updateParams, &affectedKeysSet, result);
+      result->updateType = ISAM2Result::BATCH_UPDATE;
     } else {
       recalculateIncremental(updateParams, relinKeys, affectedKeys,
                              &affectedKeysSet, &orphans, result);
+      result->updateType = ISAM2Result::INCREMENTAL_UPDATE;
+    }
+
+    // Calibrate the cost of the strategy taken, as a running average
+    if (params_.enableRecalculationCostModel) {
+      const double seconds = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+      costModel_.measured(batch, batch ? batchWork : incrementalWork, seconds);
     }
 
     // Root clique variables for detailed results
@@ -167,6 +208,9 @@ void ISAM2::recalculate(const ISAM2UpdateParams& updateParams,
 
     // Update replaced keys mask (accumulates until back-substitution happens)
     deltaReplacedMask_.insert(affectedKeysSet.begin(), affectedKeysSet.end());
+
+    // Re-eliminated variables are candidates for tree maintenance again
+    for (Key key : affectedKeysSet) maintainedKeys_.erase(key);
   }
 }
 
@@ -195,6 +239,9 @@ void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
   if (updateParams.constrainedKeys) {
     order = Ordering::ColamdConstrained(affectedFactorsVarIndex,
                                         *updateParams.constrainedKeys);
+  } else if (updateParams.batchIngestion) {
+    // One global fill-reducing ordering
+    order = Ordering::Create(updateParams.batchOrderingType, nonlinearFactors_);
   } else {
     if (theta_.size() > result->observedKeys.size()) {
       // Only if some variables are unconstrained
@@ -356,12 +403,371 @@ void ISAM2::recalculateIncremental(const ISAM2UpdateParams& updateParams,
   // 4. The orphans have already been inserted during elimination
 }
 
+/* ************************************************************************* */
+namespace internal {
+// Rotate the rows of a factor into the augmented matrix [R S d] of a
+// conditional, with R upper-triangular, such that [R S d]'*[R S d] changes by
+// +/- [A b]'*[A b].  What remains of the rows on [S d] is to be passed on to
+// the parent clique.  Downdates use hyperbolic rotations and fail if R would
+// lose (numerical) positive definiteness.
+static bool choleskyUpdate(Matrix* Rd, Matrix* rows, bool downdate) {
+  static const double kDowndateTolerance = 1e-8;
+  const DenseIndex n = Rd->rows(), cols = Rd->cols();
+  for (DenseIndex i = 0; i < rows->rows(); ++i) {
+    for (DenseIndex k = 0; k < n; ++k) {
+      const double r = (*Rd)(k, k), w = (*rows)(i, k);
+      if (w == 0.0) continue;
+      double c, s;
+      if (!downdate) {
+        const double h = std::hypot(r, w);
+        c = r / h;
+        s = w / h;
+      } else {
+        const double rho = w / r, q = 1.0 - rho * rho;
+        if (q < kDowndateTolerance) return false;
+        c = 1.0 / std::sqrt(q);
+        s = -rho * c;
+      }
+      for (DenseIndex j = k; j < cols; ++j) {
+        const double rkj = (*Rd)(k, j), wij = (*rows)(i, j);
+        (*Rd)(k, j) = c * rkj + s * wij;
+        (*rows)(i, j) = (downdate ? s : -s) * rkj + c * wij;
+      }
+    }
+  }
+  return true;
+}
+
+// Working copy of a conditional being updated by ISAM2::choleskyUpdate
+struct CliqueUpdate {
+  Matrix Rd;                          // augmented matrix [R S d]
+  std::vector<DenseIndex> dims;       // dimensions of all variables
+  FastMap<Key, DenseIndex> columns;   // column of each variable in Rd
+  GaussianFactorGraph passedUp;       // changes to the separator marginal
+  bool downdated = false;
+};
+}  // namespace internal
+
+/* ************************************************************************* */
+bool ISAM2::choleskyUpdate(const ISAM2UpdateParams& updateParams,
+                           const KeySet& relinKeys,
+                           const GaussianFactorGraph& removedFactors,
+                           ISAM2Result* result) {
+  gttic(choleskyUpdate);
+  // Any reordering, relinearization, or new or removed variables require
+  // re-elimination
+  if (result->markedKeys.empty() || !relinKeys.empty() ||
+      updateParams.batchIngestion ||
+      !result->unusedKeys.empty() || updateParams.constrainedKeys ||
+      updateParams.extraReelimKeys || updateParams.newAffectedKeys)
+    return false;
+  for (Key key : result->markedKeys)
+    if (!nodes_.exists(key)) return false;
+
+  // Conditionals are updated on copies, written back only if all succeed
+  std::map<sharedClique, internal::CliqueUpdate> updates;
+  auto updateFor = [&](const sharedClique& clique) -> internal::CliqueUpdate* {
+    auto found = updates.find(clique);
+    if (found != updates.end()) return &found->second;
+    const GaussianConditional& conditional = *clique->conditional();
+    const SharedDiagonal& model = conditional.get_model();
+    if ((model && !model->isUnit()) ||
+        conditional.R().rows() != conditional.R().cols())
+      return nullptr;
+    internal::CliqueUpdate& update = updates[clique];
+    DenseIndex column = 0;
+    for (auto it = conditional.begin(); it != conditional.end(); ++it) {
+      update.columns[*it] = column;
+      update.dims.push_back(conditional.getDim(it));
+      column += update.dims.back();
+    }
+    update.Rd.resize(conditional.R().rows(), column + 1);
+    update.Rd << conditional.R(), conditional.S(), conditional.d();
+    return &update;
+  };
+
+  // Rotates the whitened rows of a Jacobian factor into the clique it was
+  // eliminated in, the one containing all of its variables, and passes what
+  // remains on the separator up to the root, as elimination would.  The
+  // structure of the Bayes tree is unchanged.
+  Matrix rows;
+  auto rotate = [&](const GaussianFactor::shared_ptr& factor, bool downdate) {
+    if (!factor) return true;
+    auto jacobian = boost::dynamic_pointer_cast<JacobianFactor>(factor);
+    if (!jacobian) return false;
+    if (jacobian->get_model()) {
+      if (jacobian->get_model()->isConstrained()) return false;
+      jacobian = boost::make_shared<JacobianFactor>(jacobian->whiten());
+    }
+
+    sharedClique clique;
+    for (Key key : *jacobian) {
+      const sharedClique& candidate = nodes_[key];
+      const auto& variables = candidate->conditional()->keys();
+      if (std::all_of(jacobian->begin(), jacobian->end(), [&](Key j) {
+            return std::find(variables.begin(), variables.end(), j) !=
+                   variables.end();
+          })) {
+        clique = candidate;
+        break;
+      }
+    }
+    if (!clique) return false;  // would cause fill-in
+
+    while (clique) {
+      internal::CliqueUpdate* update = updateFor(clique);
+      if (!update) return false;
+      const DenseIndex n = update->Rd.rows(), cols = update->Rd.cols();
+      rows.setZero(jacobian->rows(), cols);
+      for (auto it = jacobian->begin(); it != jacobian->end(); ++it)
+        rows.middleCols(update->columns.at(*it), jacobian->getDim(it)) =
+            jacobian->getA(it);
+      rows.col(cols - 1) = jacobian->getb();
+      if (!internal::choleskyUpdate(&update->Rd, &rows, downdate))
+        return false;
+
+      // At the root, only the error remains
+      const sharedClique parent = clique->parent();
+      if (!parent) break;
+      const GaussianConditional& conditional = *clique->conditional();
+      VerticalBlockMatrix Ab(
+          std::vector<DenseIndex>(update->dims.begin() + conditional.nrFrontals(),
+                                  update->dims.end()),
+          rows.rows(), true);
+      Ab.matrix() = rows.rightCols(cols - n);
+      jacobian = boost::make_shared<JacobianFactor>(
+          KeyVector(conditional.beginParents(), conditional.endParents()), Ab);
+      update->passedUp.push_back(downdate ? jacobian->negate() : jacobian);
+      update->downdated = update->downdated || downdate;
+      clique = parent;
+    }
+    return true;
+  };
+
+  // Updates first, so downdates are less likely to lose definiteness
+  gttic(rotate);
+  for (const auto index : result->newFactorsIndices)
+    if (!rotate(linearFactors_[index], false)) return false;
+  for (const auto& factor : removedFactors)
+    if (!rotate(factor, true)) return false;
+  gttoc(rotate);
+
+  // Add what was passed up to the cached separator marginals
+  std::map<sharedClique, GaussianFactor::shared_ptr> cachedFactors;
+  for (auto& clique_update : updates) {
+    const sharedClique& clique = clique_update.first;
+    internal::CliqueUpdate& update = clique_update.second;
+    GaussianFactor::shared_ptr cached = clique->cachedFactor();
+    if (!update.passedUp.empty()) {
+      if (cached) update.passedUp.push_back(cached);
+      if (!cached || boost::dynamic_pointer_cast<HessianFactor>(cached))
+        cached = boost::make_shared<HessianFactor>(update.passedUp);
+      else if (!update.downdated)
+        cached = boost::make_shared<JacobianFactor>(update.passedUp);
+      else
+        return false;  // cannot remove rows from a Jacobian
+    }
+    cachedFactors[clique] = cached;
+  }
+
+  // Replace the conditionals, which also updates their gradient contributions
+  for (auto& clique_update : updates) {
+    const sharedClique& clique = clique_update.first;
+    const internal::CliqueUpdate& update = clique_update.second;
+    const GaussianConditional& conditional = *clique->conditional();
+    VerticalBlockMatrix Ab(update.dims, update.Rd.rows(), true);
+    Ab.matrix() = update.Rd;
+    clique->setEliminationResult(
+        std::make_pair(boost::make_shared<GaussianConditional>(
+                           conditional.keys(), conditional.nrFrontals(), Ab),
+                       cachedFactors[clique]));
+
+    // Update replaced keys mask (accumulates until back-substitution happens)
+    deltaReplacedMask_.insert(clique->conditional()->beginFrontals(),
+                              clique->conditional()->endFrontals());
+
+    // Root clique variables for detailed results
+    if (!clique->parent() && result->detail && params_.enableDetailedResults) {
+      for (Key var : *clique->conditional())
+        result->detail->variableStatus[var].inRootClique = true;
+    }
+  }
+
+  // Cached separator marginals and shortcuts in the subtree of every updated
+  // clique were computed from the old conditionals. Updated cliques below
+  // another updated clique are covered when clearing the subtree of that one.
+  for (auto& clique_update : updates) {
+    const sharedClique parent = clique_update.first->parent();
+    if (!parent || !updates.count(parent))
+      clique_update.first->deleteCachedShortcuts();
+  }
+
+  result->variablesReeliminated = 0;
+  result->factorsRecalculated =
+      result->newFactorsIndices.size() + removedFactors.size();
+  result->updateType = ISAM2Result::CHOLESKY_UPDATE;
+  return true;
+}
+
+/* ************************************************************************* */
+namespace internal {
+// Collect the largest subtrees with at most maxVariables frontal variables,
+// returns the number of frontal variables in the subtree of clique
+static size_t findSubtrees(const ISAM2::sharedClique& clique,
+                           size_t maxVariables, ISAM2::Cliques* subtrees) {
+  const size_t first = subtrees->size();
+  size_t variables = clique->conditional()->nrFrontals();
+  for (const ISAM2::sharedClique& child : clique->children)
+    variables += findSubtrees(child, maxVariables, subtrees);
+  if (variables <= maxVariables) {
+    // This subtree includes all of those found below
+    subtrees->resize(first);
+    subtrees->push_back(clique);
+  }
+  return variables;
+}
+
+// Collect the frontal variables of a subtree and their total dimension
+static size_t subtreeKeys(const ISAM2::sharedClique& clique, KeyVector* keys) {
+  keys->insert(keys->end(), clique->conditional()->beginFrontals(),
+               clique->conditional()->endFrontals());
+  size_t dim = clique->conditional()->rows();
+  for (const ISAM2::sharedClique& child : clique->children)
+    dim += subtreeKeys(child, keys);
+  return dim;
+}
+}  // namespace internal
+
+/* ************************************************************************* */
+size_t ISAM2::reorderStaleSubtree(size_t maxVariables) {
+  gttic(reorderStaleSubtree);
+
+  // Pick the subtree with the most fill-in among those not yet maintained
+  gttic(choose);
+  Cliques candidates;
+  for (const sharedClique& root : roots_)
+    internal::findSubtrees(root, maxVariables, &candidates);
+
+  sharedClique subtree;
+  KeyVector keys;
+  size_t nnz = 0;
+  double worstFill = 0.0;
+  for (const sharedClique& candidate : candidates) {
+    // A single clique is eliminated densely, reordering does not help
+    if (candidate->children.empty()) continue;
+    KeyVector candidateKeys;
+    const size_t dim = internal::subtreeKeys(candidate, &candidateKeys);
+    if (std::all_of(candidateKeys.begin(), candidateKeys.end(),
+                    [&](Key key) { return maintainedKeys_.exists(key); }))
+      continue;
+    const size_t candidateNnz = candidate->calculate_nnz();
+    const double fill = double(candidateNnz) / double(dim);
+    if (fill > worstFill) {
+      worstFill = fill;
+      subtree = candidate;
+      keys.swap(candidateKeys);
+      nnz = candidateNnz;
+    }
+  }
+  gttoc(choose);
+  if (!subtree) return 0;
+  maintainedKeys_.insert(keys.begin(), keys.end());
+
+  // Gather the factors that were eliminated in the subtree
+  gttic(gather);
+  FactorIndexSet factorIndices;
+  for (Key key : keys)
+    factorIndices.insert(variableIndex_[key].begin(),
+                         variableIndex_[key].end());
+  GaussianFactorGraph factors;
+  factors.reserve(factorIndices.size());
+  for (const auto index : factorIndices)
+    factors.push_back(params_.cacheLinearizedFactors
+                          ? linearFactors_[index]
+                          : nonlinearFactors_[index]->linearize(theta_));
+  gttoc(gather);
+
+  // Re-order, keeping the separator of the subtree last, and eliminate only
+  // the subtree variables
+  gttic(reorder_and_eliminate);
+  const KeySet subtreeKeys(keys.begin(), keys.end());
+  VariableIndex factorsVarIndex(factors);
+  KeyVector separator;
+  for (const auto& key_factors : factorsVarIndex)
+    if (!subtreeKeys.exists(key_factors.first))
+      separator.push_back(key_factors.first);
+  Ordering ordering =
+      Ordering::ColamdConstrainedLast(factorsVarIndex, separator);
+  ordering.resize(keys.size());
+
+  ISAM2BayesTree::shared_ptr bayesTree =
+      ISAM2JunctionTree(
+          GaussianEliminationTree(factors, factorsVarIndex, ordering))
+          .eliminate(params_.getEliminationFunction())
+          .first;
+  gttoc(reorder_and_eliminate);
+
+  size_t newNnz = 0;
+  for (const sharedClique& root : bayesTree->roots())
+    newNnz += root->calculate_nnz();
+  if (newNnz >= nnz) return 0;
+
+  // Swap in the new subtree, hanging its roots under the old parent, which
+  // contains their separators
+  gttic(swap);
+  const sharedClique parent = subtree->parent();
+  Roots& siblings = parent ? parent->children : roots_;
+  siblings.erase(std::find(siblings.begin(), siblings.end(), subtree));
+  for (const sharedClique& root : bayesTree->roots()) {
+    root->parent_ = parent;
+    siblings.push_back(root);
+  }
+  subtree->parent_.reset();
+  for (const auto& key_clique : bayesTree->nodes())
+    nodes_[key_clique.first] = key_clique.second;
+  gttoc(swap);
+
+  // The solution does not change, but is recomputed from the new cliques
+  deltaReplacedMask_.insert(keys.begin(), keys.end());
+  return keys.size();
+}
+
+/* ************************************************************************* */
+FastMap<FactorIndex, FactorIndex> ISAM2::compactFactors() {
+  gttic(compactFactors);
+
+  // Linear factors are not always kept for the latest nonlinear factors
+  linearFactors_.resize(nonlinearFactors_.size());
+
+  // Move the remaining factors to the front, keeping their order
+  FastMap<FactorIndex, FactorIndex> oldToNew;
+  FactorIndices newIndices(nonlinearFactors_.size());
+  FactorIndex nrFactors = 0;
+  for (FactorIndex i = 0; i < nonlinearFactors_.size(); ++i) {
+    if (!nonlinearFactors_[i]) continue;
+    newIndices[i] = nrFactors;
+    oldToNew.emplace(i, nrFactors);
+    nonlinearFactors_[nrFactors] = nonlinearFactors_[i];
+    linearFactors_[nrFactors] = linearFactors_[i];
+    ++nrFactors;
+  }
+
+  nonlinearFactors_.resize(nrFactors);
+  nonlinearFactors_.shrink_to_fit();
+  linearFactors_.resize(nrFactors);
+  linearFactors_.shrink_to_fit();
+  variableIndex_.renumberFactors(newIndices, nrFactors);
+  return oldToNew;
+}
+
 /* ************************************************************************* */
 void ISAM2::addVariables(const Values& newTheta,
                          ISAM2Result::DetailedResults* detail) {
   gttic(addNewVariables);
 
   theta_.insert(newTheta);
+  estimate_.insert(newTheta);
+  markEstimatesOutdated(newTheta.keys());
   if (ISDEBUG("ISAM2 AddVariables")) newTheta.print("The new variables are: ");
   // Add zeros into the VectorValues
   delta_.insert(newTheta.zeroVectors());
@@ -386,9 +792,12 @@ void ISAM2::removeVariables(const KeySet& unusedKeys) {
     deltaNewton_.erase(key);
     RgProd_.erase(key);
     deltaReplacedMask_.erase(key);
+    estimate_.erase(key);
+    estimateOutdated_.erase(key);
     Base::nodes_.unsafe_erase(key);
     theta_.erase(key);
     fixedVariables_.erase(key);
+    maintainedKeys_.erase(key);
   }
 }
 
@@ -422,7 +831,17 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
 
   // Update delta if we need it to check relinearization later
   if (update.relinarizationNeeded(update_count_))
-    updateDelta(updateParams.forceFullSolve);
+    updateDelta(updateParams.forceFullSolve || updateParams.batchIngestion);
+
+  // Keep the linearized factors that are removed, as they were eliminated, for
+  // downdating the root conditional
+  GaussianFactorGraph removedFactors;
+  if (params_.enableCholeskyUpdate) {
+    for (const auto index : updateParams.removeFactorIndices)
+      removedFactors.push_back(params_.cacheLinearizedFactors
+                                   ? linearFactors_[index]
+                                   : nonlinearFactors_[index]->linearize(theta_));
+  }
 
   // 1. Add any new factors \Factors:=\Factors\cup\Factors'.
   update.pushBackFactors(newFactors, &nonlinearFactors_, &linearFactors_,
@@ -455,6 +874,7 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
       // 6. Update linearization point for marked variables:
       // \Theta_{J}:=\Theta_{J}+\Delta_{J}.
       UpdateImpl::ExpmapMasked(delta_, relinKeys, &theta_);
+      markEstimatesOutdated(relinKeys);
     }
     result.variablesRelinearized = result.markedKeys.size();
   }
@@ -465,8 +885,11 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   update.augmentVariableIndex(newFactors, result.newFactorsIndices,
                               &variableIndex_);
 
-  // 8. Redo top of Bayes tree and update data structures
-  recalculate(updateParams, relinKeys, &result);
+  // 8. Redo top of Bayes tree and update data structures, unless the root
+  // conditional can be updated in place
+  if (!params_.enableCholeskyUpdate ||
+      !choleskyUpdate(updateParams, relinKeys, removedFactors, &result))
+    recalculate(updateParams, relinKeys, &result);
   if (!result.unusedKeys.empty()) removeVariables(result.unusedKeys);
   result.cliques = this->nodes().size();
 
@@ -707,8 +1130,11 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
     const double effectiveWildfireThreshold =
         forceFullSolve ? 0.0 : gaussNewtonParams.wildfireThreshold;
     gttic(Wildfire_update);
-    DeltaImpl::UpdateGaussNewtonDelta(roots_, deltaReplacedMask_,
-                                      effectiveWildfireThreshold, &delta_);
+    // A full solve may change every delta, the wildfire reports its changes
+    if (effectiveWildfireThreshold <= 0.0) allEstimatesOutdated_ = true;
+    DeltaImpl::UpdateGaussNewtonDelta(
+        roots_, deltaReplacedMask_, effectiveWildfireThreshold, &delta_,
+        allEstimatesOutdated_ ? nullptr : &estimateOutdated_);
     deltaReplacedMask_.clear();
     gttoc(Wildfire_update);
 
@@ -723,17 +1149,32 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
     gttic(Dogleg_Iterate);
 
     // Compute Newton's method step
-    gttic(Wildfire_update);
-    DeltaImpl::UpdateGaussNewtonDelta(
-        roots_, deltaReplacedMask_, effectiveWildfireThreshold, &deltaNewton_);
-    gttoc(Wildfire_update);
+    auto computeNewtonStep = [&]() {
+      gttic(Wildfire_update);
+      DeltaImpl::UpdateGaussNewtonDelta(roots_, deltaReplacedMask_,
+                                        effectiveWildfireThreshold,
+                                        &deltaNewton_);
+      gttoc(Wildfire_update);
+    };
 
     // Compute steepest descent step
-    const VectorValues gradAtZero = this->gradientAtZero();  // Compute gradient
-    DeltaImpl::UpdateRgProd(roots_, deltaReplacedMask_, gradAtZero,
-                            &RgProd_);  // Update RgProd
-    const VectorValues dx_u = DeltaImpl::ComputeGradientSearch(
-        gradAtZero, RgProd_);  // Compute gradient search point
+    VectorValues dx_u;
+    auto computeGradientSearchStep = [&]() {
+      const VectorValues gradAtZero =
+          this->gradientAtZero();  // Compute gradient
+      DeltaImpl::UpdateRgProd(roots_, deltaReplacedMask_, gradAtZero,
+                              &RgProd_);  // Update RgProd
+      dx_u = DeltaImpl::ComputeGradientSearch(
+          gradAtZero, RgProd_);  // Compute gradient search point
+    };
+
+    // Both only read the Bayes tree, and write to different members
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_invoke(computeNewtonStep, computeGradientSearchStep);
+#else
+    computeNewtonStep();
+    computeGradientSearchStep();
+#endif
 
     // Clear replaced keys mask because now we've updated deltaNewton_ and
     // RgProd_
@@ -753,6 +1194,7 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
     delta_ =
         doglegResult
             .dx_d;  // Copy the VectorValues containing with the linear solution
+    allEstimatesOutdated_ = true;
     gttoc(Copy_dx_d);
   } else {
     throw std::runtime_error("iSAM2: unknown ISAM2Params type");
@@ -760,24 +1202,77 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
 }
 
 /* ************************************************************************* */
-Values ISAM2::calculateEstimate() const {
-  gttic(ISAM2_calculateEstimate);
-  const VectorValues& delta(getDelta());
+void ISAM2::updateEstimate() const {
+  // Collect the out-of-date estimates, looked up once
+  struct Retraction {
+    Value* estimate;
+    const Value* theta;
+    const Vector* delta;
+  };
+  std::vector<Retraction> outdated;
+  auto collect = [&](Key key) {
+    outdated.push_back(
+        {&estimate_.find(key)->value, &theta_.at(key), &delta_.at(key)});
+  };
+  if (allEstimatesOutdated_) {
+    outdated.reserve(estimate_.size());
+    for (Key key : theta_.keys()) collect(key);
+  } else {
+    outdated.reserve(estimateOutdated_.size());
+    for (Key key : estimateOutdated_) collect(key);
+  }
+  allEstimatesOutdated_ = false;
+  estimateOutdated_.clear();
+
+  // Retract in place, the variables are independent
   gttic(Expmap);
-  return theta_.retract(delta);
+  auto retract = [&outdated](size_t i) {
+    Value* retracted = outdated[i].theta->retract_(*outdated[i].delta);
+    *outdated[i].estimate = *retracted;
+    retracted->deallocate_();
+  };
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, outdated.size()),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                      for (size_t i = range.begin(); i != range.end(); ++i)
+                        retract(i);
+                    });
+#else
+  for (size_t i = 0; i < outdated.size(); ++i) retract(i);
+#endif
   gttoc(Expmap);
 }
 
+/* ************************************************************************* */
+const Values& ISAM2::calculateEstimate() const {
+  gttic(ISAM2_calculateEstimate);
+  std::lock_guard<Mutex> lock(estimateMutex_);
+  if (!deltaReplacedMask_.empty()) updateDelta();
+  updateEstimate();
+  return estimate_;
+}
+
 /* ************************************************************************* */
 const Value& ISAM2::calculateEstimate(Key key) const {
-  const Vector& delta = getDelta()[key];
-  return *theta_.at(key).retract_(delta);
+  std::lock_guard<Mutex> lock(estimateMutex_);
+  if (!deltaReplacedMask_.empty()) updateDelta();
+  const Value& theta = theta_.at(key);  // Throws for unknown variables
+  Value& estimate = estimate_.find(key)->value;
+  if (allEstimatesOutdated_ || estimateOutdated_.erase(key)) {
+    Value* retracted = theta.retract_(delta_.at(key));
+    estimate = *retracted;
+    retracted->deallocate_();
+    // Recomputed again by the next updateEstimate() if all are out of date
+  }
+  return estimate;
 }
 
 /* ************************************************************************* */
-Values ISAM2::calculateBestEstimate() const {
+const Values& ISAM2::calculateBestEstimate() const {
+  std::lock_guard<Mutex> lock(estimateMutex_);
   updateDelta(true);  // Force full solve when updating delta_
-  return theta_.retract(delta_);
+  updateEstimate();
+  return estimate_;
 }
 
 /* ************************************************************************* */
@@ -789,6 +1284,7 @@ Matrix ISAM2::marginalCovariance(Key key) const {
 
 /* ************************************************************************* */
 const VectorValues& ISAM2::getDelta() const {
+  std::lock_guard<Mutex> lock(estimateMutex_);
   if (!deltaReplacedMask_.empty()) updateDelta();
   return delta_;
 }
@@ -22,11 +22,13 @@
 
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/nonlinear/ISAM2Clique.h>
+#include <gtsam/nonlinear/ISAM2CostModel.h>
 #include <gtsam/nonlinear/ISAM2Params.h>
 #include <gtsam/nonlinear/ISAM2Result.h>
 #include <gtsam/nonlinear/ISAM2UpdateParams.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 
+#include <mutex>
 #include <vector>
 
 namespace gtsam {
@@ -76,6 +78,25 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   mutable KeySet deltaReplacedMask_;  // TODO(dellaert): Make sure accessed in
                                       // the right way
 
+  /** The estimate theta_ retracted by delta_, as returned by
+   * calculateEstimate().  Only the estimates of the variables in
+   * estimateOutdated_, whose theta_ or delta_ changed since they were
+   * computed, are recomputed, or all of them if allEstimatesOutdated_ is set.
+   */
+  mutable Values estimate_;
+  mutable KeySet estimateOutdated_;
+  mutable bool allEstimatesOutdated_;
+
+  /** A mutex that is not copied along with the ISAM2 instance */
+  struct Mutex : std::mutex {
+    Mutex() {}
+    Mutex(const Mutex&) : std::mutex() {}
+    Mutex& operator=(const Mutex&) { return *this; }
+  };
+
+  /** Serializes the calls that bring delta_ and estimate_ up to date */
+  mutable Mutex estimateMutex_;
+
   /** All original nonlinear factors are stored here to use during
    * relinearization */
   NonlinearFactorGraph nonlinearFactors_;
@@ -96,6 +117,14 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   int update_count_;  ///< Counter incremented every update(), used to determine
                       ///< periodic relinearization
 
+  /** Measured cost of batch and incremental recalculation, see
+   * ISAM2Params::enableRecalculationCostModel */
+  ISAM2CostModel costModel_;
+
+  /** Variables whose subtree was considered by reorderStaleSubtree() and has
+   * not been re-eliminated since */
+  KeySet maintainedKeys_;
+
  public:
   using This = ISAM2;                       ///< This class
   using Base = BayesTree<ISAM2Clique>;      ///< The BayesTree base class
@@ -201,6 +230,30 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
       boost::optional<FactorIndices&> marginalFactorsIndices = boost::none,
       boost::optional<FactorIndices&> deletedFactorsIndices = boost::none);
 
+  /** Tree maintenance, meant to be called when idle between updates.  Over
+   * time the parts of the Bayes tree below the re-eliminated top keep their
+   * old variable ordering and accumulate fill-in.  This picks, among the
+   * largest subtrees of at most \c maxVariables variables that changed since
+   * last maintained, the one with the most nonzeros per dimension, re-orders
+   * it with COLAMD and re-eliminates it.  The new subtree replaces the old one
+   * only once complete and if it has fewer nonzeros, so the work of a call is
+   * bounded and the tree is never left partially updated.  The solution is
+   * unchanged.
+   * @return the number of variables in the replaced subtree, 0 if none
+   */
+  size_t reorderStaleSubtree(size_t maxVariables = 1000);
+
+  /** Drop the empty slots that removed factors leave behind in the factor
+   * graph, renumbering the remaining factors in their current order and
+   * shrinking the factor graphs and the VariableIndex to fit.  In long runs
+   * that remove factors, e.g. fixed-lag smoothing, this bounds memory and the
+   * cost of iterating over the factors.  Any stored FactorIndices, such as
+   * those returned in ISAM2Result::newFactorsIndices, have to be translated
+   * with the returned map.
+   * @return map from the old to the new index of every remaining factor
+   */
+  FastMap<FactorIndex, FactorIndex> compactFactors();
+
   /// Access the current linearization point
   const Values& getLinearizationPoint() const { return theta_; }
 
@@ -210,9 +263,16 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   /** Compute an estimate from the incomplete linear delta computed during the
    * last update. This delta is incomplete because it was not updated below
    * wildfire_threshold.  If only a single variable is needed, it is faster to
-   * call calculateEstimate(const KEY&).
+   * call calculateEstimate(const KEY&).  Estimates are cached, only those of
+   * variables whose delta or linearization point changed since the last call
+   * are recomputed (in parallel if TBB is enabled).  The cache is returned
+   * without copying, its contents change with the next call to update(),
+   * marginalizeLeaves() or calculateBestEstimate(), so copy the result to keep
+   * it.  Concurrent calls are serialized and leave the result unchanged, but
+   * none of these other methods may run concurrently with any call, or while
+   * another thread reads a returned estimate.
    */
-  Values calculateEstimate() const;
+  const Values& calculateEstimate() const;
 
   /** Compute an estimate for a single variable using its incomplete linear
    * delta computed during the last update.  This is faster than calling the
@@ -230,7 +290,10 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
    * delta computed during the last update.  This is faster than calling the
    * no-argument version of calculateEstimate, which operates on all variables.
    * This is a non-templated version that returns a Value base class for use
-   * with the MATLAB wrapper.
+   * with the MATLAB wrapper.  The estimate is computed on first access and
+   * cached like those returned by calculateEstimate(), the returned reference
+   * stays valid until the next call to update(), marginalizeLeaves() or
+   * calculateBestEstimate().
    * @param key
    * @return
    */
@@ -243,11 +306,14 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   /// @{
 
   /** Compute an estimate using a complete delta computed by a full
-   * back-substitution.
+   * back-substitution.  Like calculateEstimate(), this returns the cached
+   * estimate without copying, it changes every estimate and so must not run
+   * concurrently with any other method.
    */
-  Values calculateBestEstimate() const;
+  const Values& calculateBestEstimate() const;
 
-  /** Access the current delta, computed during the last call to update */
+  /** Access the current delta, computed during the last call to update.
+   * Concurrent calls are serialized like those of calculateEstimate(). */
   const VectorValues& getDelta() const;
 
   /** Compute the linear error */
@@ -301,6 +367,20 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
                               KeySet* affectedKeysSet, Cliques* orphans,
                               ISAM2Result* result);
 
+  /**
+   * Try to apply new and removed factors as rank-k up/downdates of the
+   * conditionals of the cliques they involve and their ancestors, see
+   * ISAM2Params::enableCholeskyUpdate.
+   * @param removedFactors linearized factors being removed, as they were
+   * eliminated into the Bayes tree
+   * @return false if the update does not qualify, in which case nothing was
+   * changed and recalculate has to be called
+   */
+  bool choleskyUpdate(const ISAM2UpdateParams& updateParams,
+                      const KeySet& relinKeys,
+                      const GaussianFactorGraph& removedFactors,
+                      ISAM2Result* result);
+
   /**
    * Add new variables to the ISAM2 system.
    * @param newTheta Initial values for new variables
@@ -315,6 +395,16 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   void removeVariables(const KeySet& unusedKeys);
 
   void updateDelta(bool forceFullSolve = false) const;
+
+  /// Bring estimate_ up to date with delta_, requires estimateMutex_
+  void updateEstimate() const;
+
+  /// Mark the estimates of the given variables as out of date
+  template <class KEYS>
+  void markEstimatesOutdated(const KEYS& keys) const {
+    if (!allEstimatesOutdated_)
+      estimateOutdated_.insert(keys.begin(), keys.end());
+  }
 };  // ISAM2
 
 /// traits
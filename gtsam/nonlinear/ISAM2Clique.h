@@ -170,8 +170,11 @@ class GTSAM_EXPORT ISAM2Clique
 size_t optimizeWildfire(const ISAM2Clique::shared_ptr& root, double threshold,
                         const KeySet& replaced, VectorValues* delta);
 
+/// Non-recursive version of optimizeWildfire(), if given changedKeys is
+/// extended by the variables whose delta changed by at least the threshold
 size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
                                     double threshold, const KeySet& replaced,
-                                    VectorValues* delta);
+                                    VectorValues* delta,
+                                    KeySet* changedKeys = nullptr);
 
 }  // namespace gtsam
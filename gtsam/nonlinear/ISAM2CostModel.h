@@ -0,0 +1,91 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2CostModel.h
+ * @brief   Predicts the cost of batch and incremental iSAM2 recalculation.
+ */
+
+// \callgraph
+
+#pragma once
+
+#include <gtsam/nonlinear/ISAM2Result.h>
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+
+namespace gtsam {
+
+/**
+ * @addtogroup ISAM2
+ * Chooses between a batch and an incremental recalculation from their running
+ * times per unit of work, calibrated on previous steps, see
+ * ISAM2Params::enableRecalculationCostModel.  Kept apart from ISAM2 so that the
+ * decisions can be checked with given rather than measured times.
+ */
+struct GTSAM_EXPORT ISAM2CostModel {
+  /** Running average of the seconds per unit of work of each strategy, unset
+   * until first measured */
+  boost::optional<double> batchCost, incrementalCost;
+
+  /** Seconds spent recalculating since the batch or incremental strategy was
+   * last taken, used to decide when to measure it again */
+  double batchIdleTime = 0.0, incrementalIdleTime = 0.0;
+
+  /** Weight of a new measurement in the running averages */
+  static constexpr double kSmoothing = 0.3;
+
+  /** The slower strategy is measured again once its predicted time is at most
+   * this fraction of the time spent since it was last taken */
+  static constexpr double kRemeasureFraction = 0.1;
+
+  /** Whether both strategies were measured, so that a prediction can be made */
+  bool calibrated() const { return batchCost && incrementalCost; }
+
+  /**
+   * Predict the running times for the given amounts of work into result, and
+   * return whether a batch step is to be taken.  A single bad measurement must
+   * not rule out the other strategy for good, so it is chosen again once a
+   * fraction of the time spent since it was last taken would pay for it, which
+   * bounds the overhead.  Requires calibrated().
+   */
+  bool chooseBatch(double batchWork, double incrementalWork,
+                   ISAM2Result* result) const {
+    result->predictedBatchTime = *batchCost * batchWork;
+    result->predictedIncrementalTime = *incrementalCost * incrementalWork;
+    const bool batch =
+        *result->predictedBatchTime < *result->predictedIncrementalTime;
+    if (batch)
+      return *result->predictedIncrementalTime >
+             kRemeasureFraction * incrementalIdleTime;
+    return *result->predictedBatchTime <= kRemeasureFraction * batchIdleTime;
+  }
+
+  /** Calibrate the strategy taken from the seconds a step with the given
+   * amount of work took */
+  void measured(bool batch, double work, double seconds) {
+    const double cost = seconds / std::max(work, 1.0);
+    boost::optional<double>& modelCost = batch ? batchCost : incrementalCost;
+    modelCost =
+        modelCost ? (1.0 - kSmoothing) * *modelCost + kSmoothing * cost : cost;
+    if (batch) {
+      batchIdleTime = 0.0;
+      incrementalIdleTime += seconds;
+    } else {
+      incrementalIdleTime = 0.0;
+      batchIdleTime += seconds;
+    }
+  }
+};
+
+}  // namespace gtsam
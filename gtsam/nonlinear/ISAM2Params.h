@@ -223,6 +223,32 @@ struct GTSAM_EXPORT ISAM2Params {
   /// cost of having to search for slots every time a factor is added.
   bool findUnusedFactorSlots;
 
+  /** When no variables are added, removed or relinearized, and the variables
+   * of each new and removed factor are contained in a single clique, apply
+   * the factors as rank-k Cholesky up- and downdates instead of
+   * re-eliminating (default: false).  The whitened rows are rotated into the
+   * square-root factor of that clique with Givens rotations (hyperbolic ones
+   * for removed factors), as in the original iSAM, and the remainder is passed
+   * up to the root, so the ordering and the structure of the tree stay the
+   * same.  This avoids all symbolic work and relinearization, e.g. when
+   * adding measurements on the most recent variables.  Updates that do not
+   * qualify, and downdates that would become ill-conditioned, fall back to
+   * re-elimination.  See ISAM2Result::updateType for the path taken.
+   */
+  bool enableCholeskyUpdate;
+
+  /** Choose between batch and incremental recalculation of the Bayes tree by
+   * predicting the running time of both (default: false).  The cost per unit
+   * of work of each strategy is calibrated from the measured time of previous
+   * recalculations; until both have been measured, and when this is disabled,
+   * a batch step is taken whenever 65% or more of the variables are affected.
+   * The strategy predicted to be slower is measured again once 10% of the
+   * time spent since it was last taken would pay for it, so that one bad
+   * measurement cannot decide all later updates.  The predictions are
+   * reported in ISAM2Result, see ISAM2CostModel.
+   */
+  bool enableRecalculationCostModel;
+
   /**
    * Specify parameters as constructor arguments
    * See the documentation of member variables above.
@@ -246,7 +272,9 @@ struct GTSAM_EXPORT ISAM2Params {
         keyFormatter(_keyFormatter),
         enableDetailedResults(_enableDetailedResults),
         enablePartialRelinearizationCheck(false),
-        findUnusedFactorSlots(false) {}
+        findUnusedFactorSlots(false),
+        enableCholeskyUpdate(false),
+        enableRecalculationCostModel(false) {}
 
   /// print iSAM2 parameters
   void print(const std::string& str = "") const {
@@ -288,6 +316,10 @@ struct GTSAM_EXPORT ISAM2Params {
          << enablePartialRelinearizationCheck << "\n";
     cout << "findUnusedFactorSlots:             " << findUnusedFactorSlots
          << "\n";
+    cout << "enableCholeskyUpdate:              " << enableCholeskyUpdate
+         << "\n";
+    cout << "enableRecalculationCostModel:      "
+         << enableRecalculationCostModel << "\n";
     cout.flush();
   }
 
@@ -312,6 +344,10 @@ struct GTSAM_EXPORT ISAM2Params {
   bool isEnablePartialRelinearizationCheck() const {
     return enablePartialRelinearizationCheck;
   }
+  bool isEnableCholeskyUpdate() const { return enableCholeskyUpdate; }
+  bool isEnableRecalculationCostModel() const {
+    return enableRecalculationCostModel;
+  }
 
   void setOptimizationParams(OptimizationParams optimizationParams) {
     this->optimizationParams = optimizationParams;
@@ -344,6 +380,12 @@ struct GTSAM_EXPORT ISAM2Params {
       bool enablePartialRelinearizationCheck) {
     this->enablePartialRelinearizationCheck = enablePartialRelinearizationCheck;
   }
+  void setEnableCholeskyUpdate(bool enableCholeskyUpdate) {
+    this->enableCholeskyUpdate = enableCholeskyUpdate;
+  }
+  void setEnableRecalculationCostModel(bool enableRecalculationCostModel) {
+    this->enableRecalculationCostModel = enableRecalculationCostModel;
+  }
 
   GaussianFactorGraph::Eliminate getEliminationFunction() const {
     return factorization == CHOLESKY
@@ -110,6 +110,26 @@ struct ISAM2Result {
   /** All keys that were marked during the update process. */
   KeySet markedKeys;
 
+  /** The ways in which the Bayes tree can be brought up to date */
+  enum UpdateType {
+    NO_UPDATE,           ///< Nothing was marked, the tree is unchanged
+    INCREMENTAL_UPDATE,  ///< The top of the tree was re-eliminated
+    BATCH_UPDATE,        ///< The whole tree was reordered and re-eliminated
+    CHOLESKY_UPDATE      ///< Conditionals were up/downdated in place,
+                         ///< see ISAM2Params::enableCholeskyUpdate
+  };
+
+  /** How the Bayes tree was updated during this call to ISAM2::update(). */
+  UpdateType updateType;
+
+  /** The running times, in seconds, predicted for a batch and for an
+   * incremental recalculation, which were used to choose between the two.
+   * Only set if ISAM2Params::enableRecalculationCostModel is enabled and both
+   * strategies have been calibrated.
+   */
+  boost::optional<double> predictedBatchTime;
+  boost::optional<double> predictedIncrementalTime;
+
   /**
    * A struct holding detailed results, which must be enabled with
    * ISAM2Params::enableDetailedResults.
@@ -157,7 +177,8 @@ struct ISAM2Result {
    * Detail for information about the results data stored here. */
   boost::optional<DetailedResults> detail;
 
-  explicit ISAM2Result(bool enableDetailedResults = false) {
+  explicit ISAM2Result(bool enableDetailedResults = false)
+      : updateType(NO_UPDATE) {
     if (enableDetailedResults) detail.reset(DetailedResults());
   }
 
@@ -176,6 +197,7 @@ struct ISAM2Result {
   size_t getVariablesRelinearized() const { return variablesRelinearized; }
   size_t getVariablesReeliminated() const { return variablesReeliminated; }
   size_t getCliques() const { return cliques; }
+  UpdateType getUpdateType() const { return updateType; }
 };
 
 }  // namespace gtsam
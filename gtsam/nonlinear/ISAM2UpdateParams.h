@@ -19,6 +19,7 @@
 #include <gtsam/base/FastList.h>
 #include <gtsam/dllexport.h>              // GTSAM_EXPORT
 #include <gtsam/inference/Key.h>          // Key, KeySet
+#include <gtsam/inference/Ordering.h>     // Ordering::OrderingType
 #include <gtsam/nonlinear/ISAM2Result.h>  //FactorIndices
 #include <boost/optional.hpp>
 
@@ -69,6 +70,18 @@ struct ISAM2UpdateParams {
    * the deltas become too small down in the tree. This flagg forces a full
    * solve instead. */
   bool forceFullSolve{false};
+
+  /** Ingest a large set of new factors, e.g. many loop closures released at
+   * once, in a single batch step: all variables are relinearized once (unless
+   * relinearization is disabled), the whole Bayes tree is reordered with
+   * \c batchOrderingType, without constraining the observed variables last,
+   * and eliminated once.  Later updates continue incrementally.  This bounds
+   * the latency to about that of one batch solve, where the same factors
+   * passed to regular updates can cause several near-full re-eliminations. */
+  bool batchIngestion{false};
+
+  /** The global ordering used for batchIngestion (default: COLAMD) */
+  Ordering::OrderingType batchOrderingType{Ordering::COLAMD};
 };
 
 }  // namespace gtsam
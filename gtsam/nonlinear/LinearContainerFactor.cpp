@@ -11,8 +11,32 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 
+#include <typeinfo>
+
 namespace gtsam {
 
+namespace {
+// Vectors of up to this size are kept on the stack by error() and linearize()
+const size_t kStackSize = 64;
+
+// A vector on the stack if it is small enough, on the heap otherwise, so that
+// error() and linearize() do not allocate for small factors yet keep no state
+class ScratchVector {
+ public:
+  explicit ScratchVector(size_t n)
+      : heap_(n > kStackSize ? n : 0),
+        vector_(n > kStackSize ? heap_.data() : stack_, n) {}
+  ScratchVector(const ScratchVector&) = delete;
+  ScratchVector& operator=(const ScratchVector&) = delete;
+  Eigen::Map<Vector>& vector() { return vector_; }
+
+ private:
+  double stack_[kStackSize];
+  Vector heap_;
+  Eigen::Map<Vector> vector_;
+};
+}
+
 /* ************************************************************************* */
 void LinearContainerFactor::initializeLinearizationPoint(const Values& linearizationPoint) {
   if (!linearizationPoint.empty()) {
@@ -23,12 +47,42 @@ void LinearContainerFactor::initializeLinearizationPoint(const Values& lineariza
   } else {
     linearizationPoint_ = boost::none;
   }
+  initializeOffsets();
+}
+
+/* ************************************************************************* */
+void LinearContainerFactor::initializeOffsets() {
+  offsets_.clear();
+  if (!linearizationPoint_)
+    return;
+
+  // Blocks of the stored linear factor are in keys() order
+  offsets_.reserve(size() + 1);
+  size_t dim = 0;
+  for (Key key : keys()) {
+    offsets_.push_back(dim);
+    dim += linearizationPoint_->at(key).dim();
+  }
+  offsets_.push_back(dim);
+}
+
+/* ************************************************************************* */
+void LinearContainerFactor::localCoordinates(const Values& c, Eigen::Map<Vector>& delta) const {
+  for (size_t j = 0; j < size(); ++j) {
+    const Value& linearized = linearizationPoint_->at(keys_[j]);
+    delta.segment(offsets_[j], linearized.dim()) =
+        linearized.localCoordinates_(c.at(keys_[j]));
+  }
 }
 
 /* ************************************************************************* */
 LinearContainerFactor::LinearContainerFactor(const GaussianFactor::shared_ptr& factor,
     const boost::optional<Values>& linearizationPoint)
-: NonlinearFactor(factor->keys()), factor_(factor), linearizationPoint_(linearizationPoint) {
+: NonlinearFactor(factor->keys()), factor_(factor) {
+  // Only the variables of the factor are kept, so that error() and
+  // linearize() cost does not grow with the size of a full estimate
+  if (linearizationPoint)
+    initializeLinearizationPoint(*linearizationPoint);
 }
 
 /* ************************************************************************* */
@@ -78,18 +132,37 @@ double LinearContainerFactor::error(const Values& c) const {
   if (!linearizationPoint_)
     return 0;
 
-  // Extract subset of values for comparison
-  Values csub;
-  for (Key key : keys())
-    csub.insert(key, c.at(key));
-
-  // create dummy ordering for evaluation
-  VectorValues delta = linearizationPoint_->localCoordinates(csub);
+  // Delta between linearization points, contiguous in keys() order
+  ScratchVector delta(offsets_.back());
+  localCoordinates(c, delta.vector());
 
   // compute error
-  double error = factor_->error(delta);
-
-  return error;
+  if (typeid(*factor_) == typeid(JacobianFactor)) {
+    const JacobianFactor& jacobian = static_cast<const JacobianFactor&>(*factor_);
+    ScratchVector residual(jacobian.rows());
+    Eigen::Map<Vector>& r = residual.vector();
+    r.noalias() = jacobian.getA() * delta.vector();
+    r -= jacobian.getb();
+    const SharedDiagonal& model = jacobian.get_model();
+    if (!model)
+      return 0.5 * r.squaredNorm();
+    if (model->isConstrained())
+      return 0.5 * model->distance(r);
+    return 0.5 * r.cwiseProduct(model->invsigmas()).squaredNorm();
+  } else if (typeid(*factor_) == typeid(HessianFactor)) {
+    // error 0.5*(f - 2*x'*g + x'*G*x)
+    const HessianFactor& hessian = static_cast<const HessianFactor&>(*factor_);
+    ScratchVector G_delta(offsets_.back());
+    G_delta.vector().noalias() = hessian.informationView() * delta.vector();
+    return 0.5 * (hessian.constantTerm() - 2.0 * delta.vector().dot(hessian.linearTerm().col(0))
+        + delta.vector().dot(G_delta.vector()));
+  } else {
+    // Other factor types need a VectorValues
+    VectorValues deltaValues;
+    for (size_t j = 0; j < size(); ++j)
+      deltaValues.insert(keys_[j], delta.vector().segment(offsets_[j], offsets_[j + 1] - offsets_[j]));
+    return factor_->error(deltaValues);
+  }
 }
 
 /* ************************************************************************* */
@@ -107,26 +180,21 @@ GaussianFactor::shared_ptr LinearContainerFactor::linearize(const Values& c) con
   if (!hasLinearizationPoint())
     return linFactor;
 
-  // Extract subset of values
-  Values subsetC;
-  for (Key key : keys())
-    subsetC.insert(key, c.at(key));
-
-  // Determine delta between linearization points using new ordering
-  VectorValues delta = linearizationPoint_->localCoordinates(subsetC);
+  // Determine delta between linearization points, contiguous in keys() order
+  ScratchVector delta(offsets_.back());
+  localCoordinates(c, delta.vector());
 
   // Apply changes due to relinearization
   if (isJacobian()) {
-    JacobianFactor::shared_ptr jacFactor = boost::dynamic_pointer_cast<JacobianFactor>(linFactor);
-    jacFactor->getb() = -jacFactor->unweighted_error(delta);
+    JacobianFactor::shared_ptr jacFactor = boost::static_pointer_cast<JacobianFactor>(linFactor);
+    jacFactor->getb().noalias() -= jacFactor->getA() * delta.vector();
   } else {
-    HessianFactor::shared_ptr hesFactor = boost::dynamic_pointer_cast<HessianFactor>(linFactor);
-
-    const auto view = hesFactor->informationView();
-    Vector deltaVector = delta.vector(keys());
-    Vector G_delta = view * deltaVector;
-    hesFactor->constantTerm() += deltaVector.dot(G_delta) - 2.0 * deltaVector.dot(hesFactor->linearTerm().col(0));
-    hesFactor->linearTerm() -= G_delta;
+    HessianFactor::shared_ptr hesFactor = boost::static_pointer_cast<HessianFactor>(linFactor);
+    ScratchVector G_delta(offsets_.back());
+    G_delta.vector().noalias() = hesFactor->informationView() * delta.vector();
+    hesFactor->constantTerm() += delta.vector().dot(G_delta.vector())
+        - 2.0 * delta.vector().dot(hesFactor->linearTerm().col(0));
+    hesFactor->linearTerm() -= G_delta.vector();
   }
 
   return linFactor;
@@ -29,6 +29,9 @@ protected:
   GaussianFactor::shared_ptr factor_;
   boost::optional<Values> linearizationPoint_;
 
+  /// Offset of each variable of keys() in the stacked delta, followed by the total dimension
+  std::vector<size_t> offsets_;
+
   /** Default constructor - necessary for serialization */
   LinearContainerFactor() {}
 
@@ -153,6 +156,12 @@ public:
 protected:
 	GTSAM_EXPORT void initializeLinearizationPoint(const Values& linearizationPoint);
 
+  /// Precompute the location of each variable in the stacked delta
+  GTSAM_EXPORT void initializeOffsets();
+
+  /// Compute linearizationPoint_.localCoordinates(c) stacked in keys() order, without copying values
+  GTSAM_EXPORT void localCoordinates(const Values& c, Eigen::Map<Vector>& delta) const;
+
 private:
 
   /** Serialization function */
@@ -163,6 +172,8 @@ private:
         boost::serialization::base_object<Base>(*this));
     ar & BOOST_SERIALIZATION_NVP(factor_);
     ar & BOOST_SERIALIZATION_NVP(linearizationPoint_);
+    if (ARCHIVE::is_loading::value)
+      initializeOffsets();
   }
 
 }; // \class LinearContainerFactor
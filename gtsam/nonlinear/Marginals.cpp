@@ -29,7 +29,7 @@ namespace gtsam {
 Marginals::Marginals(const NonlinearFactorGraph& graph, const Values& solution, Factorization factorization)
                      : values_(solution), factorization_(factorization) {
   gttic(MarginalsConstructor);
-  graph_ = *graph.linearize(solution);
+  graph_ = *graph.linearizeExpanded(solution);
   computeBayesTree();
 }
 
@@ -38,7 +38,7 @@ Marginals::Marginals(const NonlinearFactorGraph& graph, const Values& solution,
                      Factorization factorization)
                      : values_(solution), factorization_(factorization) {
   gttic(MarginalsConstructor);
-  graph_ = *graph.linearize(solution);
+  graph_ = *graph.linearizeExpanded(solution);
   computeBayesTree(ordering);
 }
 
@@ -28,19 +28,6 @@ namespace gtsam {
 
 typedef internal::NonlinearOptimizerState State;
 
-/**
- * @brief Return the gradient vector of a nonlinear factor graph
- * @param nfg the graph
- * @param values a linearization point
- * Can be moved to NonlinearFactorGraph.h if desired
- */
-static VectorValues gradientInPlace(const NonlinearFactorGraph &nfg,
-    const Values &values) {
-  // Linearize graph
-  GaussianFactorGraph::shared_ptr linear = nfg.linearize(values);
-  return linear->gradientAtZero();
-}
-
 NonlinearConjugateGradientOptimizer::NonlinearConjugateGradientOptimizer(
     const NonlinearFactorGraph& graph, const Values& initialValues, const Parameters& params)
     : Base(graph, std::unique_ptr<State>(new State(initialValues, graph.error(initialValues)))),
@@ -52,7 +39,8 @@ double NonlinearConjugateGradientOptimizer::System::error(const State& state) co
 
 NonlinearConjugateGradientOptimizer::System::Gradient NonlinearConjugateGradientOptimizer::System::gradient(
     const State &state) const {
-  return gradientInPlace(graph_, state);
+  // Accumulate the gradient directly, no need to linearize the graph
+  return graph_.gradientAtZero(state);
 }
 
 NonlinearConjugateGradientOptimizer::System::State NonlinearConjugateGradientOptimizer::System::advance(
@@ -167,6 +167,11 @@ public:
         new JacobianFactor(this->key(), A, b, model));
   }
 
+  /// Gradient has to follow the over-written linearize above
+  virtual void gradientAtZero(const Values& x, VectorValues& g) const {
+    NonlinearFactor::gradientAtZero(x, g);
+  }
+
   /// @return a deep copy of this factor
   virtual gtsam::NonlinearFactor::shared_ptr clone() const {
     return boost::static_pointer_cast<gtsam::NonlinearFactor>(
@@ -17,6 +17,7 @@
  */
 
 #include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/linear/VectorValues.h>
 #include <boost/make_shared.hpp>
 #include <boost/format.hpp>
 
@@ -59,6 +60,14 @@ NonlinearFactor::shared_ptr NonlinearFactor::rekey(
   return new_factor;
 }
 
+/* ************************************************************************* */
+void NonlinearFactor::gradientAtZero(const Values& c, VectorValues& g) const {
+  const boost::shared_ptr<GaussianFactor> gaussian = linearize(c);
+  if (!gaussian) return;
+  for (const VectorValues::value_type& key_value : gaussian->gradientAtZero())
+    g.at(key_value.first) += key_value.second;
+}
+
 /* ************************************************************************* */
 void NoiseModelFactor::print(const std::string& s,
     const KeyFormatter& keyFormatter) const {
@@ -163,6 +172,26 @@ boost::shared_ptr<GaussianFactor> NoiseModelFactor::linearize(
     return GaussianFactor::shared_ptr(new JacobianFactor(terms, b));
 }
 
+/* ************************************************************************* */
+void NoiseModelFactor::gradientAtZero(const Values& x, VectorValues& g) const {
+
+  // Only active factors contribute to the gradient
+  if (!active(x))
+    return;
+
+  // Same whitened system as in linearize, but g -= A'*b is accumulated directly
+  std::vector<Matrix> A(size());
+  Vector b = -unwhitenedError(x, A);
+  check(noiseModel_, b.size());
+  if (noiseModel_)
+    noiseModel_->WhitenSystem(A, b);
+
+  // A constrained model is replaced by its unit() version in linearize, which
+  // leaves the whitened system unchanged in gradientAtZero.
+  for (size_t j = 0; j < size(); ++j)
+    g.at(keys()[j]).noalias() -= A[j].transpose() * b;
+}
+
 /* ************************************************************************* */
 
 } // \namespace gtsam
@@ -116,6 +116,14 @@ public:
   virtual boost::shared_ptr<GaussianFactor>
   linearize(const Values& c) const = 0;
 
+  /**
+   * Add the gradient of error() at c, taken with respect to the local
+   * coordinates of this factor's variables, into g. This is the same as
+   * linearize(c)->gradientAtZero(), which is what the default implementation
+   * does. g must already contain correctly sized entries for all keys.
+   */
+  virtual void gradientAtZero(const Values& c, VectorValues& g) const;
+
   /**
    * Creates a shared_ptr clone of the factor - needs to be specialized to allow
    * for subclasses
@@ -251,6 +259,12 @@ public:
    */
   boost::shared_ptr<GaussianFactor> linearize(const Values& x) const;
 
+  /**
+   * Add the whitened gradient \f$ -A^T b \f$ of the linearized system into g,
+   * without creating a JacobianFactor.
+   */
+  void gradientAtZero(const Values& x, VectorValues& g) const override;
+
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
   /// @name Deprecated
   /// @{
@@ -0,0 +1,70 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    NonlinearFactorBlock.cpp
+ * @brief   Base class for blocks of many factors of one type
+ */
+
+#include <gtsam/nonlinear/NonlinearFactorBlock.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <stdexcept>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+size_t NonlinearFactorBlock::slot(Key key) {
+  if (slots_.size() != keys_.size()) {
+    slots_.clear();
+    for (size_t position = 0; position < keys_.size(); ++position)
+      slots_.insert(std::make_pair(keys_[position], position));
+  }
+  const std::pair<FastMap<Key, size_t>::iterator, bool> inserted =
+      slots_.insert(std::make_pair(key, keys_.size()));
+  if (inserted.second)
+    keys_.push_back(key);
+  return inserted.first->second;
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph NonlinearFactorBlock::linearizeFactors(
+    const Values& values) const {
+  GaussianFactorGraph graph;
+  graph.resize(nrFactors());
+  linearizeInto(values, graph, 0);
+  return graph;
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<GaussianFactor> NonlinearFactorBlock::linearize(
+    const Values& values) const {
+  if (keys_.size() > maxDenseKeys)
+    throw std::invalid_argument(
+        "NonlinearFactorBlock::linearize: too many keys for a dense factor, "
+        "use NonlinearFactorGraph::linearizeExpanded or split the block");
+  return boost::make_shared<JacobianFactor>(linearizeFactors(values));
+}
+
+/* ************************************************************************* */
+void NonlinearFactorBlock::gradientAtZero(const Values& values,
+                                          VectorValues& g) const {
+  for (const GaussianFactor::shared_ptr& factor : linearizeFactors(values)) {
+    if (!factor) continue;
+    for (const VectorValues::value_type& key_value : factor->gradientAtZero())
+      g.at(key_value.first) += key_value.second;
+  }
+}
+
+/* ************************************************************************* */
+
+} // \namespace gtsam
@@ -0,0 +1,107 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    NonlinearFactorBlock.h
+ * @brief   Base class for blocks of many factors of one type
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/base/FastMap.h>
+
+namespace gtsam {
+
+/**
+ * A block of many factors of one type that is a single entry in a
+ * NonlinearFactorGraph. Derived classes store the measurements, keys and noise
+ * of their member factors in contiguous arrays, and linearize all members in
+ * one loop, without a virtual call or a noise model object per factor.
+ *
+ * The keys() of a block are the union of the keys of its members.
+ * NonlinearFactorGraph::linearizeExpanded and ordering expand a block into its
+ * members, so that elimination sees the same structure as with separate
+ * factors; the Gauss-Newton, Levenberg-Marquardt and Dogleg optimizers use
+ * these, as do Marginals. Everywhere else, e.g. in
+ * NonlinearFactorGraph::linearize and hence in ISAM2 and the fixed-lag
+ * smoothers, a block acts as one factor on all its keys, and linearize(values)
+ * returns a single dense JacobianFactor.  This is only practical for small
+ * blocks, so linearize throws for blocks on more than maxDenseKeys keys.
+ */
+class GTSAM_EXPORT NonlinearFactorBlock: public NonlinearFactor {
+
+protected:
+
+  typedef NonlinearFactor Base;
+  typedef NonlinearFactorBlock This;
+
+  /**
+   * Position of key in keys(), which it is appended to if not there yet.
+   * Members should refer to keys by position, so that rekey() works.
+   */
+  size_t slot(Key key);
+
+private:
+
+  /// Position of every key in keys(), rebuilt when stale, e.g. after rekey()
+  FastMap<Key, size_t> slots_;
+
+public:
+
+  typedef boost::shared_ptr<This> shared_ptr;
+
+  /** Most keys a block can have to be linearized as a single factor */
+  static const size_t maxDenseKeys = 8;
+
+  /** Default constructor, creates an empty block */
+  NonlinearFactorBlock() {}
+
+  /** Copy constructor, the copy rebuilds its key positions as rekey() changes
+   * its keys */
+  NonlinearFactorBlock(const NonlinearFactorBlock& other) : Base(other) {}
+
+  /** Destructor */
+  virtual ~NonlinearFactorBlock() {}
+
+  /// @name Standard Interface
+  /// @{
+
+  /** Number of member factors in the block */
+  virtual size_t nrFactors() const = 0;
+
+  /** Keys of member factor i */
+  virtual KeyVector factorKeys(size_t i) const = 0;
+
+  /**
+   * Linearize all members into graph[start] to graph[start + nrFactors() - 1],
+   * which must already exist. No other entries of graph are touched, so that
+   * several blocks can linearize into the same graph in parallel.
+   */
+  virtual void linearizeInto(const Values& values, GaussianFactorGraph& graph,
+      size_t start) const = 0;
+
+  /** Linearize all members, with one GaussianFactor per member */
+  GaussianFactorGraph linearizeFactors(const Values& values) const;
+
+  /** Linearize to a single JacobianFactor on all keys(), throws
+   * std::invalid_argument if there are more than maxDenseKeys */
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& values) const;
+
+  /** Add the gradient of all members at values into g */
+  virtual void gradientAtZero(const Values& values, VectorValues& g) const;
+
+  /// @}
+
+}; // \class NonlinearFactorBlock
+
+} // \namespace gtsam
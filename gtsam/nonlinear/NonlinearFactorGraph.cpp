@@ -22,6 +22,7 @@
 #include <gtsam/symbolic/SymbolicFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/NonlinearFactorBlock.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/linearExceptions.h>
 #include <gtsam/linear/VectorValues.h>
@@ -31,10 +32,12 @@
 
 #ifdef GTSAM_USE_TBB
 #  include <tbb/parallel_for.h>
+#  include <tbb/enumerable_thread_specific.h>
 #endif
 
 #include <cmath>
 #include <limits>
+#include <numeric>
 
 using namespace std;
 
@@ -252,6 +255,19 @@ void NonlinearFactorGraph::saveGraph(std::ostream &stm, const Values& values,
 /* ************************************************************************* */
 double NonlinearFactorGraph::error(const Values& values) const {
   gttic(NonlinearFactorGraph_error);
+#ifdef GTSAM_USE_TBB
+  // evaluate factors in parallel, but sum in a fixed order so the result is
+  // independent of the scheduling
+  std::vector<double> errors(size(), 0.0);
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
+    [&](const tbb::blocked_range<size_t>& blocked_range) {
+      for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i)
+        if (factors_[i])
+          errors[i] = factors_[i]->error(values);
+    });
+  return std::accumulate(errors.begin(), errors.end(), 0.0);
+#else
   double total_error = 0.;
   // iterate over all the factors_ to accumulate the log probabilities
   for(const sharedFactor& factor: factors_) {
@@ -259,17 +275,61 @@ double NonlinearFactorGraph::error(const Values& values) const {
       total_error += factor->error(values);
   }
   return total_error;
+#endif
+}
+
+/* ************************************************************************* */
+namespace {
+
+// The factor as a NonlinearFactorBlock, or nullptr if it is not one
+const NonlinearFactorBlock* asBlock(const NonlinearFactor::shared_ptr& factor) {
+  return dynamic_cast<const NonlinearFactorBlock*>(factor.get());
+}
+
+bool hasFactorBlocks(const NonlinearFactorGraph& graph) {
+  for (const NonlinearFactor::shared_ptr& factor : graph)
+    if (asBlock(factor))
+      return true;
+  return false;
+}
+
+// The symbolic structure of linearizeExpanded, with one factor per member of
+// every block
+SymbolicFactorGraph expandedSymbolic(const NonlinearFactorGraph& graph) {
+  SymbolicFactorGraph symbolic;
+  symbolic.reserve(graph.size());
+  for (const NonlinearFactor::shared_ptr& factor : graph) {
+    if (const NonlinearFactorBlock* block = asBlock(factor)) {
+      for (size_t i = 0; i < block->nrFactors(); ++i)
+        symbolic += SymbolicFactor::FromKeys(block->factorKeys(i));
+    } else if (factor)
+      symbolic += SymbolicFactor(*factor);
+  }
+  return symbolic;
+}
+
+}
+
+/* ************************************************************************* */
+Ordering NonlinearFactorGraph::ordering(Ordering::OrderingType orderingType) const
+{
+  // A block is one factor on all its keys, so order its members instead
+  if (hasFactorBlocks(*this))
+    return Ordering::Create(orderingType, expandedSymbolic(*this));
+  return Ordering::Create(orderingType, *this);
 }
 
 /* ************************************************************************* */
 Ordering NonlinearFactorGraph::orderingCOLAMD() const
 {
-  return Ordering::Colamd(*this);
+  return ordering(Ordering::COLAMD);
 }
 
 /* ************************************************************************* */
 Ordering NonlinearFactorGraph::orderingCOLAMDConstrained(const FastMap<Key, int>& constraints) const
 {
+  if (hasFactorBlocks(*this))
+    return Ordering::ColamdConstrained(expandedSymbolic(*this), constraints);
   return Ordering::ColamdConstrained(*this, constraints);
 }
 
@@ -314,6 +374,34 @@ public:
     }
   }
 };
+
+// As _LinearizeOneFactor, but expanding blocks, with factor i going to
+// result[offsets[i]] and following
+class _LinearizeOneFactorExpanded {
+  const NonlinearFactorGraph& nonlinearGraph_;
+  const Values& linearizationPoint_;
+  const std::vector<size_t>& offsets_;
+  GaussianFactorGraph& result_;
+public:
+  // Create functor with constant parameters
+  _LinearizeOneFactorExpanded(const NonlinearFactorGraph& graph,
+      const Values& linearizationPoint, const std::vector<size_t>& offsets,
+      GaussianFactorGraph& result) :
+      nonlinearGraph_(graph), linearizationPoint_(linearizationPoint),
+      offsets_(offsets), result_(result) {
+  }
+  // Operator that linearizes a given range of the factors
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i) {
+      if (const NonlinearFactorBlock* block = asBlock(nonlinearGraph_[i]))
+        block->linearizeInto(linearizationPoint_, result_, offsets_[i]);
+      else if (nonlinearGraph_[i])
+        result_[offsets_[i]] = nonlinearGraph_[i]->linearize(linearizationPoint_);
+      else
+        result_[offsets_[i]] = GaussianFactor::shared_ptr();
+    }
+  }
+};
 #endif
 
 }
@@ -350,6 +438,84 @@ GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& li
   return linearFG;
 }
 
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearizeExpanded(
+    const Values& linearizationPoint) const
+{
+  if (!hasFactorBlocks(*this))
+    return linearize(linearizationPoint);
+
+  gttic(NonlinearFactorGraph_linearizeExpanded);
+
+  // Index of the first linear factor of every factor, blocks have one per member
+  std::vector<size_t> offsets(size() + 1, 0);
+  for (size_t i = 0; i < size(); ++i) {
+    const NonlinearFactorBlock* block = asBlock(factors_[i]);
+    offsets[i + 1] = offsets[i] + (block ? block->nrFactors() : 1);
+  }
+
+  GaussianFactorGraph::shared_ptr linearFG = boost::make_shared<GaussianFactorGraph>();
+  linearFG->resize(offsets.back());
+
+#ifdef GTSAM_USE_TBB
+
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
+    _LinearizeOneFactorExpanded(*this, linearizationPoint, offsets, *linearFG));
+
+#else
+
+  for (size_t i = 0; i < size(); ++i) {
+    if (const NonlinearFactorBlock* block = asBlock(factors_[i]))
+      block->linearizeInto(linearizationPoint, *linearFG, offsets[i]);
+    else if (factors_[i])
+      (*linearFG)[offsets[i]] = factors_[i]->linearize(linearizationPoint);
+  }
+
+#endif
+
+  return linearFG;
+}
+
+/* ************************************************************************* */
+void NonlinearFactorGraph::gradientAtZero(const Values& values,
+                                          VectorValues& g) const {
+  gttic(NonlinearFactorGraph_gradientAtZero);
+  g.setZero();
+
+#ifdef GTSAM_USE_TBB
+
+  // Factors sharing a variable would race on g, so every thread accumulates
+  // into its own copy, and the copies are summed afterwards.
+  tbb::enumerable_thread_specific<VectorValues> partialGradients(g);
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
+    [&](const tbb::blocked_range<size_t>& blocked_range) {
+      VectorValues& partial = partialGradients.local();
+      for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i)
+        if (factors_[i])
+          factors_[i]->gradientAtZero(values, partial);
+    });
+  for (const VectorValues& partial : partialGradients)
+    g += partial;
+
+#else
+
+  for (const sharedFactor& factor : factors_) {
+    if (factor)
+      factor->gradientAtZero(values, g);
+  }
+
+#endif
+}
+
+/* ************************************************************************* */
+VectorValues NonlinearFactorGraph::gradientAtZero(const Values& values) const {
+  VectorValues g = values.zeroVectors();
+  gradientAtZero(values, g);
+  return g;
+}
+
 /* ************************************************************************* */
 static Scatter scatterFromValues(const Values& values) {
   gttic(scatterFromValues);
@@ -393,7 +559,10 @@ HessianFactor::shared_ptr NonlinearFactorGraph::linearizeToHessianFactor(
   // linearize all factors straight into the Hessian
   // TODO(frank): this saves on creating the graph, but still mallocs a gaussianFactor!
   for (const sharedFactor& nonlinearFactor : factors_) {
-    if (nonlinearFactor) {
+    if (const NonlinearFactorBlock* block = asBlock(nonlinearFactor)) {
+      for (const auto& gaussianFactor : block->linearizeFactors(values))
+        gaussianFactor->updateHessian(hessianFactor->keys_, &hessianFactor->info_);
+    } else if (nonlinearFactor) {
       const auto& gaussianFactor = nonlinearFactor->linearize(values);
       gaussianFactor->updateHessian(hessianFactor->keys_, &hessianFactor->info_);
     }
@@ -24,6 +24,7 @@
 #include <gtsam/geometry/Point2.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/inference/FactorGraph.h>
+#include <gtsam/inference/Ordering.h>
 #include <gtsam/nonlinear/PriorFactor.h>
 
 #include <boost/shared_ptr.hpp>
@@ -33,7 +34,6 @@ namespace gtsam {
 
   // Forward declarations
   class Values;
-  class Ordering;
   class GaussianFactorGraph;
   class SymbolicFactorGraph;
   template<typename T>
@@ -116,7 +116,10 @@ namespace gtsam {
       const GraphvizFormatting& graphvizFormatting = GraphvizFormatting(),
       const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
 
-    /** unnormalized error, \f$ 0.5 \sum_i (h_i(X_i)-z)^2/\sigma^2 \f$ in the most common case */
+    /**
+     * unnormalized error, \f$ 0.5 \sum_i (h_i(X_i)-z)^2/\sigma^2 \f$ in the most common case.
+     * Factors are evaluated in parallel if TBB is available.
+     */
     double error(const Values& values) const;
 
     /** Unnormalized probability. O(n) */
@@ -127,6 +130,13 @@ namespace gtsam {
      */
     boost::shared_ptr<SymbolicFactorGraph> symbolic() const;
 
+    /**
+     * Compute an ordering of the given type. The members of any
+     * NonlinearFactorBlock are seen as separate factors, as they are in
+     * linearizeExpanded.
+     */
+    Ordering ordering(Ordering::OrderingType orderingType = Ordering::COLAMD) const;
+
     /**
      * Compute a fill-reducing ordering using COLAMD.
      */
@@ -145,6 +155,31 @@ namespace gtsam {
     /// Linearize a nonlinear factor graph
     boost::shared_ptr<GaussianFactorGraph> linearize(const Values& linearizationPoint) const;
 
+    /**
+     * Linearize a nonlinear factor graph, with one GaussianFactor per member
+     * of every NonlinearFactorBlock. The linear factors then no longer
+     * correspond to the nonlinear ones by index, so this is only for solvers
+     * that eliminate the whole graph at once, such as the Gauss-Newton,
+     * Levenberg-Marquardt and Dogleg optimizers, and for Marginals.
+     * Incremental solvers such as ISAM2 use linearize, where a block is one
+     * dense factor.
+     */
+    boost::shared_ptr<GaussianFactorGraph> linearizeExpanded(const Values& linearizationPoint) const;
+
+    /**
+     * Gradient of the error at the given values, with respect to their local
+     * coordinates. Equivalent to linearize(values)->gradientAtZero(), but every
+     * factor accumulates its whitened gradient straight into g, so no
+     * GaussianFactorGraph is created. Factors are evaluated in parallel if TBB
+     * is available.
+     * @param g pre-allocated gradient, e.g. values.zeroVectors(); must contain
+     *   every key in the graph, and is overwritten.
+     */
+    void gradientAtZero(const Values& values, VectorValues& g) const;
+
+    /// Gradient of the error at the given values, contains all keys in values
+    VectorValues gradientAtZero(const Values& values) const;
+
     /// typdef for dampen functions used below
     typedef std::function<void(const boost::shared_ptr<HessianFactor>& hessianFactor)> Dampen;
 
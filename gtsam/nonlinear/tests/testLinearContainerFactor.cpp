@@ -319,6 +319,91 @@ TEST( testLinearContainerFactor, hessian_relinearize )
   CHECK(gtsam::assert_equal(*expected_factor, *actual_factor));
 }
 
+/* ************************************************************************* */
+TEST( testLinearContainerFactor, relinearize_unsorted_keys )
+{
+  // Keys of the factor are not sorted, to exercise the offsets into delta
+  gtsam::Key key1(1);
+  gtsam::Key key2(2);
+  gtsam::Values linpoint1;
+  linpoint1.insert(key1, gtsam::Pose2(1.0, 2.0, 0.1));
+  linpoint1.insert(key2, gtsam::Point3(-21.0,  +5.0, +21.0));
+  linpoint1.insert(key2 + 1, gtsam::Point3(1.0, 2.0, 3.0)); // not in factor
+
+  gtsam::SharedDiagonal model = gtsam::noiseModel::Isotropic::Sigma(3, 0.1);
+  gtsam::JacobianFactor jacobian(key2, 2.0 * I_3x3, key1, Matrix::Ones(3, 3),
+                                 Vector3(1.0, 2.0, 3.0), model);
+  gtsam::LinearContainerFactor jacobianContainer(jacobian, linpoint1);
+  gtsam::LinearContainerFactor hessianContainer(gtsam::HessianFactor(jacobian), linpoint1);
+
+  gtsam::Values linpoint2 = linpoint1;
+  linpoint2.update(key1, gtsam::Pose2(1.1, 1.9, 0.15));
+  linpoint2.update(key2, gtsam::Point3(-20.0, +5.5, +20.5));
+
+  // Expected values through the generic VectorValues interface
+  gtsam::Values linpoint1Sub, linpoint2Sub;
+  for (gtsam::Key key : jacobian.keys()) {
+    linpoint1Sub.insert(key, linpoint1.at(key));
+    linpoint2Sub.insert(key, linpoint2.at(key));
+  }
+  gtsam::VectorValues delta = linpoint1Sub.localCoordinates(linpoint2Sub);
+  gtsam::JacobianFactor expected_jacobian = jacobian;
+  expected_jacobian.getb() = -jacobian.unweighted_error(delta);
+  EXPECT_DOUBLES_EQUAL(jacobian.error(delta), jacobianContainer.error(linpoint2), 1e-9);
+  EXPECT_DOUBLES_EQUAL(jacobian.error(delta), hessianContainer.error(linpoint2), 1e-9);
+
+  // Relinearizing returns a new factor and leaves earlier results untouched
+  gtsam::GaussianFactor::shared_ptr first = jacobianContainer.linearize(linpoint1);
+  EXPECT(gtsam::assert_equal((const GaussianFactor&)jacobian, *first));
+  gtsam::GaussianFactor::shared_ptr second = jacobianContainer.linearize(linpoint2);
+  EXPECT(first != second);
+  EXPECT(gtsam::assert_equal((const GaussianFactor&)jacobian, *first));
+  EXPECT(gtsam::assert_equal((const GaussianFactor&)expected_jacobian, *second));
+
+  // Same for the Hessian version
+  gtsam::HessianFactor expected_hessian(expected_jacobian);
+  gtsam::GaussianFactor::shared_ptr hessianFirst = hessianContainer.linearize(linpoint1);
+  gtsam::GaussianFactor::shared_ptr hessianResult = hessianContainer.linearize(linpoint2);
+  EXPECT(gtsam::assert_equal((const GaussianFactor&)gtsam::HessianFactor(jacobian), *hessianFirst, 1e-9));
+  EXPECT(gtsam::assert_equal((const GaussianFactor&)expected_hessian, *hessianResult, 1e-9));
+}
+
+/* ************************************************************************* */
+namespace {
+// Exposes the constructor that keeps the linearization point as given
+struct LinearContainerFactorWithPoint : public LinearContainerFactor {
+  LinearContainerFactorWithPoint(const GaussianFactor::shared_ptr& factor,
+                                 const Values& linearizationPoint)
+      : LinearContainerFactor(factor, boost::optional<Values>(linearizationPoint)) {}
+};
+}
+
+TEST( testLinearContainerFactor, extra_linearization_point_keys )
+{
+  // Variables in the linearization point that are not in the factor are dropped
+  gtsam::Key key1(1);
+  gtsam::Key key2(2);
+  gtsam::Values linpoint1;
+  linpoint1.insert(key1, gtsam::Pose2(1.0, 2.0, 0.1));
+  linpoint1.insert(key2, gtsam::Point3(-21.0,  +5.0, +21.0));
+  gtsam::Values extended = linpoint1;
+  extended.insert(0, gtsam::Point3(1.0, 2.0, 3.0));
+  extended.insert(3, gtsam::Pose2(3.0, 2.0, 1.0));
+
+  gtsam::SharedDiagonal model = gtsam::noiseModel::Isotropic::Sigma(3, 0.1);
+  gtsam::JacobianFactor::shared_ptr jacobian = boost::make_shared<JacobianFactor>(
+      key2, 2.0 * I_3x3, key1, Matrix::Ones(3, 3), Vector3(1.0, 2.0, 3.0), model);
+  gtsam::LinearContainerFactor expected(*jacobian, linpoint1);
+  LinearContainerFactorWithPoint actual(jacobian, extended);
+  EXPECT(gtsam::assert_equal(linpoint1, *actual.linearizationPoint()));
+
+  gtsam::Values linpoint2 = linpoint1;
+  linpoint2.update(key1, gtsam::Pose2(1.1, 1.9, 0.15));
+  linpoint2.update(key2, gtsam::Point3(-20.0, +5.5, +20.5));
+  EXPECT_DOUBLES_EQUAL(expected.error(linpoint2), actual.error(linpoint2), 1e-9);
+  EXPECT(gtsam::assert_equal(*expected.linearize(linpoint2), *actual.linearize(linpoint2), 1e-9));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -0,0 +1,276 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  BetweenFactorBlock.h
+ *  @brief Many BetweenFactors on one Lie group type, stored together
+ **/
+#pragma once
+
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorBlock.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <stdexcept>
+#include <vector>
+
+namespace gtsam {
+
+  /**
+   * A block of BetweenFactor<VALUE> with Gaussian noise, for large pose graphs.
+   * The keys, measurements and square-root information matrices of all members
+   * are stored in contiguous arrays, and the members are linearized with fixed
+   * size matrices in one loop, in parallel if TBB is available. Linearizing
+   * the block gives the same JacobianFactors as linearizing the equivalent
+   * BetweenFactors one by one.
+   * @tparam VALUE the Value type, a Lie group of fixed dimension
+   * @addtogroup SLAM
+   */
+  template<class VALUE>
+  class BetweenFactorBlock: public NonlinearFactorBlock {
+
+    // Check that VALUE type is a testable Lie group
+    BOOST_CONCEPT_ASSERT((IsTestable<VALUE>));
+    BOOST_CONCEPT_ASSERT((IsLieGroup<VALUE>));
+
+  public:
+
+    typedef VALUE T;
+    enum { D = traits<VALUE>::dimension };
+    typedef Eigen::Matrix<double, D, D> MatrixD;
+    typedef Eigen::Matrix<double, D, 1> VectorD;
+
+  private:
+
+    BOOST_STATIC_ASSERT_MSG(D != Eigen::Dynamic,
+        "BetweenFactorBlock needs a VALUE type of fixed dimension");
+
+    typedef BetweenFactorBlock<VALUE> This;
+    typedef NonlinearFactorBlock Base;
+
+    std::vector<size_t> slots1_, slots2_; /** Positions of the member keys in keys() */
+    std::vector<VALUE, Eigen::aligned_allocator<VALUE> > measured_; /** The measurements */
+    std::vector<MatrixD, Eigen::aligned_allocator<MatrixD> > sqrtInformation_; /** The whitening matrices R */
+
+  public:
+
+    // shorthand for a smart pointer to a factor
+    typedef typename boost::shared_ptr<BetweenFactorBlock> shared_ptr;
+
+    /** Constructor, creates an empty block */
+    BetweenFactorBlock() {}
+
+    virtual ~BetweenFactorBlock() {}
+
+    /// @return a deep copy of this factor
+    virtual gtsam::NonlinearFactor::shared_ptr clone() const {
+      return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+          gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
+
+    /** Reserve memory for n members */
+    void reserve(size_t n) {
+      slots1_.reserve(n);
+      slots2_.reserve(n);
+      measured_.reserve(n);
+      sqrtInformation_.reserve(n);
+    }
+
+    /** Add a member with the given square-root information matrix R */
+    void add(Key key1, Key key2, const VALUE& measured, const MatrixD& R) {
+      slots1_.push_back(slot(key1));
+      slots2_.push_back(slot(key2));
+      measured_.push_back(measured);
+      sqrtInformation_.push_back(R);
+    }
+
+    /**
+     * Add a member with a Gaussian noise model, which includes the diagonal,
+     * isotropic and unit models. Constrained and robust models are not supported.
+     */
+    void add(Key key1, Key key2, const VALUE& measured,
+        const SharedNoiseModel& model = nullptr) {
+      if (!model) {
+        add(key1, key2, measured, MatrixD::Identity());
+        return;
+      }
+      noiseModel::Gaussian::shared_ptr gaussian =
+          boost::dynamic_pointer_cast<noiseModel::Gaussian>(model);
+      if (!gaussian || gaussian->isConstrained() || gaussian->dim() != D)
+        throw std::invalid_argument(
+            "BetweenFactorBlock::add: needs a Gaussian noise model of the VALUE dimension");
+      add(key1, key2, measured, MatrixD(gaussian->R()));
+    }
+
+    /** Add a BetweenFactor, see add for the supported noise models */
+    void add(const BetweenFactor<VALUE>& factor) {
+      add(factor.key1(), factor.key2(), factor.measured(), factor.noiseModel());
+    }
+
+    /** implement functions needed for Testable */
+
+    /** print */
+    virtual void print(const std::string& s = "", const KeyFormatter& keyFormatter = DefaultKeyFormatter) const {
+      std::cout << s << "BetweenFactorBlock with " << nrFactors() << " factors\n";
+      for (size_t i = 0; i < nrFactors(); ++i) {
+        std::cout << "  BetweenFactor(" << keyFormatter(key1(i)) << ","
+            << keyFormatter(key2(i)) << ")\n";
+        traits<T>::Print(measured_[i], "    measured: ");
+        std::cout << "    sqrt information:\n" << sqrtInformation_[i] << "\n";
+      }
+    }
+
+    /** equals */
+    virtual bool equals(const NonlinearFactor& expected, double tol=1e-9) const {
+      const This *e = dynamic_cast<const This*> (&expected);
+      if (e == nullptr || !Base::equals(*e, tol) || slots1_ != e->slots1_
+          || slots2_ != e->slots2_)
+        return false;
+      for (size_t i = 0; i < nrFactors(); ++i)
+        if (!traits<T>::Equals(measured_[i], e->measured_[i], tol)
+            || !equal_with_abs_tol(sqrtInformation_[i], e->sqrtInformation_[i], tol))
+          return false;
+      return true;
+    }
+
+    /** implement functions needed to derive from Factor */
+
+    /** number of members */
+    virtual size_t nrFactors() const {
+      return measured_.size();
+    }
+
+    /** keys of member i */
+    virtual KeyVector factorKeys(size_t i) const {
+      return KeyVector{key1(i), key2(i)};
+    }
+
+    /** number of rows on linearization, summed over all members */
+    virtual size_t dim() const {
+      return D * nrFactors();
+    }
+
+    /**
+     * Whitened error R*(h(x)-z) of member i, as in BetweenFactor::evaluateError,
+     * and optionally the whitened Jacobians R*H1 and R*H2
+     */
+    VectorD whitenedError(const Values& values, size_t i,
+        MatrixD* A1 = nullptr, MatrixD* A2 = nullptr) const {
+      const VALUE& p1 = values.at<VALUE>(key1(i));
+      const VALUE& p2 = values.at<VALUE>(key2(i));
+      const MatrixD& R = sqrtInformation_[i];
+      if (!A1)
+        return R * traits<T>::Local(measured_[i], traits<T>::Between(p1, p2));
+      MatrixD H1, H2;
+      T hx = traits<T>::Between(p1, p2, H1, H2); // h(x)
+#ifdef SLOW_BUT_CORRECT_BETWEENFACTOR
+      MatrixD Hlocal;
+      const VectorD e = traits<T>::Local(measured_[i], hx, boost::none, Hlocal);
+      *A1 = R * Hlocal * H1;
+      *A2 = R * Hlocal * H2;
+#else
+      const VectorD e = traits<T>::Local(measured_[i], hx);
+      A1->noalias() = R * H1;
+      A2->noalias() = R * H2;
+#endif
+      return R * e;
+    }
+
+    /** sum of the errors of all members */
+    virtual double error(const Values& values) const {
+      double total = 0.0;
+      for (size_t i = 0; i < nrFactors(); ++i)
+        total += 0.5 * whitenedError(values, i).squaredNorm();
+      return total;
+    }
+
+    /** linearize member i, same as BetweenFactor::linearize */
+    JacobianFactor::shared_ptr linearizeFactor(const Values& values, size_t i) const {
+      static const DenseIndex dims[] = {D, D};
+      VerticalBlockMatrix Ab(dims, dims + 2, D, true);
+      MatrixD A1, A2;
+      Ab(2).col(0) = -whitenedError(values, i, &A1, &A2);
+      Ab(0) = A1;
+      Ab(1) = A2;
+      return boost::make_shared<JacobianFactor>(factorKeys(i), Ab);
+    }
+
+    /** linearize all members into graph[start], ... */
+    virtual void linearizeInto(const Values& values, GaussianFactorGraph& graph,
+        size_t start) const {
+#ifdef GTSAM_USE_TBB
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, nrFactors()),
+        [&](const tbb::blocked_range<size_t>& blocked_range) {
+          for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i)
+            graph[start + i] = linearizeFactor(values, i);
+        });
+#else
+      for (size_t i = 0; i < nrFactors(); ++i)
+        graph[start + i] = linearizeFactor(values, i);
+#endif
+    }
+
+    /** add the gradient of all members into g, without creating JacobianFactors */
+    virtual void gradientAtZero(const Values& values, VectorValues& g) const {
+      MatrixD A1, A2;
+      for (size_t i = 0; i < nrFactors(); ++i) {
+        // g -= A'*b with b = -R*e
+        const VectorD e = whitenedError(values, i, &A1, &A2);
+        g.at(key1(i)).noalias() += A1.transpose() * e;
+        g.at(key2(i)).noalias() += A2.transpose() * e;
+      }
+    }
+
+    /** return the measurement of member i */
+    const VALUE& measured(size_t i) const {
+      return measured_[i];
+    }
+
+    /** return the first key of member i */
+    Key key1(size_t i) const {
+      return keys_[slots1_[i]];
+    }
+
+    /** return the second key of member i */
+    Key key2(size_t i) const {
+      return keys_[slots2_[i]];
+    }
+
+    /** return the square-root information matrix R of member i */
+    const MatrixD& sqrtInformation(size_t i) const {
+      return sqrtInformation_[i];
+    }
+
+  private:
+
+    /** Serialization function */
+    friend class boost::serialization::access;
+    template<class ARCHIVE>
+    void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+      ar & boost::serialization::make_nvp("NonlinearFactor",
+          boost::serialization::base_object<NonlinearFactor>(*this));
+      ar & BOOST_SERIALIZATION_NVP(slots1_);
+      ar & BOOST_SERIALIZATION_NVP(slots2_);
+      ar & BOOST_SERIALIZATION_NVP(measured_);
+      ar & BOOST_SERIALIZATION_NVP(sqrtInformation_);
+    }
+  }; // \class BetweenFactorBlock
+
+  /// traits
+  template<class VALUE>
+  struct traits<BetweenFactorBlock<VALUE> > : public Testable<BetweenFactorBlock<VALUE> > {};
+
+} /// namespace gtsam
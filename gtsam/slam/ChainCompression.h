@@ -0,0 +1,265 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  ChainCompression.h
+ *  @brief Reduce a pose graph by composing chains of BetweenFactors
+ **/
+#pragma once
+
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/base/FastMap.h>
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace gtsam {
+
+  /**
+   * Compress a pose graph by removing the intermediate poses of odometry chains.
+   *
+   * A key is intermediate if it is in exactly two factors, both of them
+   * BetweenFactor<POSE> with a Gaussian noise model, to two different keys.
+   * Optionally, only keys in a given set may be intermediate, e.g., to keep
+   * keyframes or other poses that will be queried. A chain is a maximal path
+   * through intermediate keys, and is replaced by a single BetweenFactor<POSE>
+   * between its end keys, with the composed measurement and its covariance
+   * propagated to first order. Chains that end where they start are left alone.
+   *
+   * After optimizing the reduced graph, expand() puts back the intermediate
+   * poses, interpolated between the optimized end poses: the discrepancy between
+   * the composed odometry and the optimized end pose is distributed along the
+   * chain in proportion to the propagated covariances, which is the conditional
+   * mean of the linearized chain given its end poses.
+   *
+   * @tparam POSE a Lie group of fixed dimension, e.g. Pose2 or Pose3
+   * @addtogroup SLAM
+   */
+  template<class POSE>
+  class ChainCompression {
+
+  public:
+
+    enum { D = traits<POSE>::dimension };
+    typedef Eigen::Matrix<double, D, D> MatrixD;
+    typedef Eigen::Matrix<double, D, 1> VectorD;
+
+    /** A chain from key a to key b that was replaced by one BetweenFactor */
+    struct Chain {
+      Key a, b;
+      KeyVector intermediates; ///< intermediate keys, in order from a to b
+      POSE measured; ///< composed measurement between a and b
+      MatrixD covariance; ///< propagated covariance of measured
+      std::vector<POSE, Eigen::aligned_allocator<POSE> > relative; ///< composed measurement between a and each intermediate
+      std::vector<MatrixD, Eigen::aligned_allocator<MatrixD> > gains; ///< maps the error at b to the correction of each intermediate
+
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+
+    typedef std::vector<Chain, Eigen::aligned_allocator<Chain> > Chains;
+
+  private:
+
+    typedef BetweenFactor<POSE> Between;
+    typedef FastMap<Key, std::pair<size_t, size_t> > Intermediates;
+
+    NonlinearFactorGraph graph_; /** The reduced graph */
+    Chains chains_; /** The chains that were compressed */
+
+    /** The factor as a BetweenFactor<POSE> with Gaussian noise, or nullptr */
+    static const Between* between(const NonlinearFactor::shared_ptr& factor) {
+      const Between* f = dynamic_cast<const Between*>(factor.get());
+      if (!f || !boost::dynamic_pointer_cast<noiseModel::Gaussian>(f->noiseModel())
+          || f->noiseModel()->isConstrained() || f->noiseModel()->dim() != D)
+        return nullptr;
+      return f;
+    }
+
+    /** The key of a between factor that is not key */
+    static Key otherKey(const Between& factor, Key key) {
+      return factor.key1() == key ? factor.key2() : factor.key1();
+    }
+
+    /**
+     * Follow the chain from intermediate key start through the given factor,
+     * appending the factors and keys passed, up to and including the first key
+     * that is not intermediate. Returns false if the chain comes back to start.
+     */
+    bool follow(const NonlinearFactorGraph& graph,
+        const Intermediates& intermediates, Key start, size_t factor,
+        std::vector<size_t>* factors, KeyVector* keys) const {
+      Key key = start;
+      while (true) {
+        factors->push_back(factor);
+        key = otherKey(*between(graph[factor]), key);
+        if (key == start)
+          return false;
+        keys->push_back(key);
+        typename Intermediates::const_iterator it = intermediates.find(key);
+        if (it == intermediates.end())
+          return true;
+        factor = (it->second.first == factor) ? it->second.second : it->second.first;
+      }
+    }
+
+    /**
+     * Compose the measurements along keys[0], ..., keys[n] of the given factors,
+     * where factor i is between keys[i] and keys[i+1].
+     */
+    Chain compose(const NonlinearFactorGraph& graph, const KeyVector& keys,
+        const std::vector<size_t>& factors) const {
+      Chain chain;
+      chain.a = keys.front();
+      chain.b = keys.back();
+      chain.intermediates.assign(keys.begin() + 1, keys.end() - 1);
+      chain.measured = traits<POSE>::Identity();
+      chain.covariance.setZero();
+
+      std::vector<MatrixD, Eigen::aligned_allocator<MatrixD> > covariances;
+      for (size_t i = 0; i < factors.size(); ++i) {
+        const Between& factor = *between(graph[factors[i]]);
+        POSE z = factor.measured();
+        MatrixD Sigma = boost::static_pointer_cast<noiseModel::Gaussian>(
+            factor.noiseModel())->covariance();
+        if (factor.key1() != keys[i]) {
+          // Factor points backwards, use the inverse measurement
+          MatrixD H;
+          z = traits<POSE>::Inverse(z, H);
+          Sigma = H * Sigma * H.transpose();
+        }
+        MatrixD H1, H2;
+        chain.measured = traits<POSE>::Compose(chain.measured, z, H1, H2);
+        chain.covariance = H1 * chain.covariance * H1.transpose()
+            + H2 * Sigma * H2.transpose();
+        if (i + 1 < factors.size()) {
+          chain.relative.push_back(chain.measured);
+          covariances.push_back(chain.covariance);
+        }
+      }
+
+      // Gain of intermediate i is Sigma_i * J_i' * Sigma^-1, with J_i the
+      // derivative of the composed measurement with respect to relative[i]
+      const MatrixD information = chain.covariance.inverse();
+      for (size_t i = 0; i < chain.relative.size(); ++i) {
+        MatrixD J;
+        traits<POSE>::Compose(chain.relative[i],
+            traits<POSE>::Between(chain.relative[i], chain.measured), J, boost::none);
+        chain.gains.push_back(covariances[i] * J.transpose() * information);
+      }
+      return chain;
+    }
+
+  public:
+
+    /**
+     * Compress all chains in graph. If removable is given, only keys in it
+     * can be intermediate.
+     */
+    ChainCompression(const NonlinearFactorGraph& graph,
+        const boost::optional<KeySet>& removable = boost::none) {
+
+      // Find the intermediate keys and their two factors
+      Intermediates intermediates;
+      VariableIndex variableIndex(graph);
+      for (const VariableIndex::value_type& key_factors : variableIndex) {
+        const Key key = key_factors.first;
+        const FactorIndices& factors = key_factors.second;
+        if (factors.size() != 2 || (removable && !removable->count(key)))
+          continue;
+        const Between* f1 = between(graph[factors.front()]);
+        const Between* f2 = between(graph[factors.back()]);
+        if (!f1 || !f2 || f1->key1() == f1->key2() || f2->key1() == f2->key2()
+            || otherKey(*f1, key) == otherKey(*f2, key))
+          continue;
+        intermediates[key] = std::make_pair(factors.front(), factors.back());
+      }
+
+      // Follow the chain through every intermediate key not visited yet
+      KeySet visited;
+      std::vector<bool> removed(graph.size(), false);
+      for (const typename Intermediates::value_type& key_factors : intermediates) {
+        const Key key = key_factors.first;
+        if (visited.count(key))
+          continue;
+        std::vector<size_t> factors, forwardFactors;
+        KeyVector keys, forwardKeys;
+        const bool isPath =
+            follow(graph, intermediates, key, key_factors.second.first, &factors, &keys)
+            && follow(graph, intermediates, key, key_factors.second.second,
+                &forwardFactors, &forwardKeys);
+
+        // Put the keys and factors in order from one end to the other
+        std::reverse(factors.begin(), factors.end());
+        std::reverse(keys.begin(), keys.end());
+        keys.push_back(key);
+        factors.insert(factors.end(), forwardFactors.begin(), forwardFactors.end());
+        keys.insert(keys.end(), forwardKeys.begin(), forwardKeys.end());
+        visited.insert(keys.begin(), keys.end());
+        if (!isPath || keys.front() == keys.back())
+          continue;
+
+        chains_.push_back(compose(graph, keys, factors));
+        for (size_t i : factors)
+          removed[i] = true;
+      }
+
+      // Keep all other factors, and add one BetweenFactor per chain
+      graph_.reserve(graph.size() + chains_.size());
+      for (size_t i = 0; i < graph.size(); ++i)
+        if (!removed[i])
+          graph_.push_back(graph[i]);
+      for (const Chain& chain : chains_)
+        graph_.emplace_shared<Between>(chain.a, chain.b, chain.measured,
+            noiseModel::Gaussian::Covariance(chain.covariance));
+    }
+
+    /** The reduced graph */
+    const NonlinearFactorGraph& graph() const {
+      return graph_;
+    }
+
+    /** The chains that were replaced by a single factor */
+    const Chains& chains() const {
+      return chains_;
+    }
+
+    /** Remove the intermediate keys from values */
+    Values reduce(const Values& values) const {
+      Values result(values);
+      for (const Chain& chain : chains_)
+        for (Key key : chain.intermediates)
+          if (result.exists(key))
+            result.erase(key);
+      return result;
+    }
+
+    /** Add the intermediate poses to values of the reduced graph */
+    Values expand(const Values& values) const {
+      Values result(values);
+      for (const Chain& chain : chains_) {
+        const POSE& xa = values.at<POSE>(chain.a);
+        const POSE& xb = values.at<POSE>(chain.b);
+        const VectorD error = traits<POSE>::Local(
+            traits<POSE>::Compose(xa, chain.measured), xb);
+        for (size_t i = 0; i < chain.intermediates.size(); ++i)
+          result.insert(chain.intermediates[i], traits<POSE>::Retract(
+              traits<POSE>::Compose(xa, chain.relative[i]), chain.gains[i] * error));
+      }
+      return result;
+    }
+  };
+
+} /// namespace gtsam
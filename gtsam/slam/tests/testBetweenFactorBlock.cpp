@@ -0,0 +1,258 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testBetweenFactorBlock.cpp
+ * @brief   Unit test for BetweenFactorBlock and NonlinearFactorBlock
+ */
+
+#include <gtsam/slam/BetweenFactorBlock.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/Marginals.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+// *************************************************************************
+namespace example {
+// Pose graph on a circle, with a loop closure between the last and first pose
+const size_t n = 8;
+const SharedNoiseModel diagonal =
+    noiseModel::Diagonal::Sigmas((Vector(6) << 0.1, 0.1, 0.1, 0.3, 0.3, 0.3).finished());
+
+SharedNoiseModel fullModel() {
+  Matrix6 information = Matrix6::Identity() * 10;
+  information(0, 4) = information(4, 0) = 2;
+  information(2, 3) = information(3, 2) = -1;
+  return noiseModel::Gaussian::Information(information);
+}
+
+Pose3 pose(size_t i) {
+  const double theta = 2 * M_PI * i / n;
+  return Pose3(Rot3::Yaw(theta + M_PI / 2),
+               Point3(cos(theta), sin(theta), 0.1 * i));
+}
+
+// Separate BetweenFactors, and the same factors in a block
+void graphs(NonlinearFactorGraph* separate,
+            BetweenFactorBlock<Pose3>::shared_ptr* block) {
+  *block = boost::make_shared<BetweenFactorBlock<Pose3> >();
+  const Pose3 noise = Pose3::Expmap((Vector(6) << 0.01, -0.02, 0.03, 0.05, 0.02, -0.01).finished());
+  for (size_t i = 0; i < n; ++i) {
+    const size_t j = (i + 1) % n;
+    const SharedNoiseModel model = (i % 2) ? diagonal : fullModel();
+    BetweenFactor<Pose3> factor(i, j, pose(i).between(pose(j)) * noise, model);
+    separate->push_back(factor);
+    (*block)->add(factor);
+  }
+}
+
+Values values() {
+  Values values;
+  for (size_t i = 0; i < n; ++i)
+    values.insert(i, pose(i).retract(0.1 * Vector6::Constant(i % 3 - 1.0)));
+  return values;
+}
+}
+
+// *************************************************************************
+TEST(BetweenFactorBlock, add) {
+  BetweenFactorBlock<Pose3> block;
+  block.add(5, 3, Pose3(), example::diagonal);
+  block.add(3, 4, Pose3());
+  block.add(1, 5, Pose3(), noiseModel::Unit::Create(6));
+  LONGS_EQUAL(3, block.nrFactors());
+  LONGS_EQUAL(18, block.dim());
+
+  // keys() are the union in order of appearance, members keep theirs
+  EXPECT(assert_container_equality(KeyVector({5, 3, 4, 1}), block.keys()));
+  EXPECT(assert_container_equality(KeyVector({5, 3}), block.factorKeys(0)));
+  EXPECT(assert_container_equality(KeyVector({3, 4}), block.factorKeys(1)));
+  EXPECT(assert_container_equality(KeyVector({1, 5}), block.factorKeys(2)));
+  EXPECT(assert_equal(Matrix(Matrix6::Identity()), Matrix(block.sqrtInformation(1))));
+
+  // Only Gaussian noise models of the right dimension
+  CHECK_EXCEPTION(block.add(1, 2, Pose3(), noiseModel::Isotropic::Sigma(3, 1)),
+                  std::invalid_argument);
+  CHECK_EXCEPTION(block.add(1, 2, Pose3(), noiseModel::Robust::Create(
+                      noiseModel::mEstimator::Huber::Create(1.0), example::diagonal)),
+                  std::invalid_argument);
+  CHECK_EXCEPTION(block.add(1, 2, Pose3(), noiseModel::Constrained::All(6)),
+                  std::invalid_argument);
+}
+
+// *************************************************************************
+TEST(BetweenFactorBlock, linearize) {
+  NonlinearFactorGraph separate;
+  BetweenFactorBlock<Pose3>::shared_ptr block;
+  example::graphs(&separate, &block);
+  const Values values = example::values();
+
+  // Same JacobianFactors and errors as the separate factors
+  GaussianFactorGraph actual = block->linearizeFactors(values);
+  LONGS_EQUAL(separate.size(), actual.size());
+  for (size_t i = 0; i < separate.size(); ++i)
+    EXPECT(assert_equal(*separate[i]->linearize(values), *actual[i], 1e-9));
+  EXPECT_DOUBLES_EQUAL(separate.error(values), block->error(values), 1e-9);
+
+  VectorValues expectedGradient = separate.gradientAtZero(values);
+  VectorValues actualGradient = values.zeroVectors();
+  block->gradientAtZero(values, actualGradient);
+  EXPECT(assert_equal(expectedGradient, actualGradient, 1e-9));
+
+  // As a single factor, the block is one dense JacobianFactor
+  GaussianFactor::shared_ptr dense = block->linearize(values);
+  VectorValues x = values.zeroVectors();
+  for (size_t i = 0; i < example::n; ++i)
+    x[i] = Vector6::Constant(0.01 * i);
+  EXPECT_DOUBLES_EQUAL(actual.error(x), dense->error(x), 1e-9);
+}
+
+// *************************************************************************
+TEST(BetweenFactorBlock, graph) {
+  NonlinearFactorGraph separate;
+  BetweenFactorBlock<Pose3>::shared_ptr block;
+  example::graphs(&separate, &block);
+  const Values values = example::values();
+
+  SharedNoiseModel priorModel = noiseModel::Isotropic::Sigma(6, 0.01);
+  separate.addPrior(0, example::pose(0), priorModel);
+  NonlinearFactorGraph graph;
+  graph.push_back(block);
+  graph.addPrior(0, example::pose(0), priorModel);
+  LONGS_EQUAL(2, graph.size());
+  EXPECT_DOUBLES_EQUAL(separate.error(values), graph.error(values), 1e-9);
+
+  // linearize keeps one factor per graph entry, linearizeExpanded and the
+  // orderings expand the block, in order
+  LONGS_EQUAL(2, graph.linearize(values)->size());
+  LONGS_EQUAL(2, graph.symbolic()->size());
+  EXPECT(assert_equal(*separate.linearize(values), *graph.linearizeExpanded(values), 1e-9));
+  EXPECT(assert_equal(*separate.linearize(values), *separate.linearizeExpanded(values)));
+  EXPECT(assert_equal(separate.orderingCOLAMD(), graph.orderingCOLAMD()));
+  EXPECT(assert_equal(separate.ordering(Ordering::METIS), graph.ordering(Ordering::METIS)));
+  EXPECT(assert_equal(separate.gradientAtZero(values), graph.gradientAtZero(values), 1e-9));
+  EXPECT(assert_equal(*separate.linearizeToHessianFactor(values),
+                      *graph.linearizeToHessianFactor(values), 1e-9));
+
+  // Optimizing gives the same result
+  Values expected = LevenbergMarquardtOptimizer(separate, values).optimize();
+  Values actual = LevenbergMarquardtOptimizer(graph, values).optimize();
+  EXPECT(assert_equal(expected, actual, 1e-6));
+}
+
+// *************************************************************************
+TEST(BetweenFactorBlock, ISAM2) {
+  NonlinearFactorGraph separate;
+  BetweenFactorBlock<Pose3>::shared_ptr block;
+  example::graphs(&separate, &block);
+  const Values values = example::values();
+  SharedNoiseModel priorModel = noiseModel::Isotropic::Sigma(6, 0.01);
+
+  // ISAM2 sees the block as one factor, and gives the same estimate
+  ISAM2 expected, actual;
+  NonlinearFactorGraph prior;
+  prior.addPrior(0, example::pose(0), priorModel);
+  separate.push_back(prior);
+  expected.update(separate, values);
+  NonlinearFactorGraph graph;
+  graph.push_back(block);
+  graph.push_back(prior);
+  ISAM2Result result = actual.update(graph, values);
+  LONGS_EQUAL(2, result.newFactorsIndices.size());
+  for (size_t i = 0; i < 2; ++i) {
+    expected.update();
+    actual.update();
+  }
+  EXPECT(assert_equal(expected.calculateEstimate(), actual.calculateEstimate(), 1e-6));
+
+  // Further updates, which relinearize the block, agree as well
+  NonlinearFactorGraph newFactors;
+  newFactors += BetweenFactor<Pose3>(0, 4, example::pose(0).between(example::pose(4)),
+                                     example::diagonal);
+  expected.update(newFactors);
+  actual.update(newFactors);
+  for (size_t i = 0; i < 2; ++i) {
+    expected.update();
+    actual.update();
+  }
+  EXPECT(assert_equal(expected.calculateEstimate(), actual.calculateEstimate(), 1e-6));
+}
+
+// *************************************************************************
+TEST(BetweenFactorBlock, large) {
+  // A chain on more keys than a single dense factor is allowed to have
+  NonlinearFactorGraph separate;
+  BetweenFactorBlock<Pose3>::shared_ptr block =
+      boost::make_shared<BetweenFactorBlock<Pose3> >();
+  Values values;
+  const size_t n = 2 * NonlinearFactorBlock::maxDenseKeys;
+  for (size_t i = 0; i < n; ++i) {
+    values.insert(i, Pose3(Rot3::Yaw(0.1 * i), Point3(i, 0.1 * i, 0)));
+    if (i == 0) continue;
+    BetweenFactor<Pose3> factor(i - 1, i, Pose3(Rot3(), Point3(1, 0, 0)),
+                                example::diagonal);
+    separate.push_back(factor);
+    block->add(factor);
+  }
+  SharedNoiseModel priorModel = noiseModel::Isotropic::Sigma(6, 0.01);
+  separate.addPrior(0, Pose3(), priorModel);
+  NonlinearFactorGraph graph;
+  graph.push_back(block);
+  graph.addPrior(0, Pose3(), priorModel);
+
+  // Linearizing as one factor is refused, also by ISAM2
+  CHECK_EXCEPTION(block->linearize(values), std::invalid_argument);
+  ISAM2 isam;
+  CHECK_EXCEPTION(isam.update(graph, values), std::invalid_argument);
+
+  // Marginals expand the block
+  Marginals expected(separate, values), actual(graph, values);
+  for (size_t i = 0; i < n; ++i)
+    EXPECT(assert_equal(expected.marginalCovariance(i),
+                        actual.marginalCovariance(i), 1e-9));
+}
+
+// *************************************************************************
+TEST(BetweenFactorBlock, rekey) {
+  BetweenFactorBlock<Pose3> block;
+  block.add(1, 2, Pose3(), example::diagonal);
+  block.add(2, 3, Pose3(), example::diagonal);
+
+  map<Key, Key> mapping{{2, 20}};
+  NonlinearFactor::shared_ptr actual = block.rekey(mapping);
+  BetweenFactorBlock<Pose3>::shared_ptr rekeyed =
+      boost::dynamic_pointer_cast<BetweenFactorBlock<Pose3> >(actual);
+  CHECK(rekeyed);
+  EXPECT(assert_container_equality(KeyVector({1, 20}), rekeyed->factorKeys(0)));
+  EXPECT(assert_container_equality(KeyVector({20, 3}), rekeyed->factorKeys(1)));
+  EXPECT(assert_container_equality(KeyVector({1, 2}), block.factorKeys(0)));
+
+  // Members added after rekey() share the new keys
+  rekeyed->add(20, 4, Pose3(), example::diagonal);
+  EXPECT(assert_container_equality(KeyVector({1, 20, 3, 4}), rekeyed->keys()));
+  EXPECT(assert_container_equality(KeyVector({20, 4}), rekeyed->factorKeys(2)));
+}
+
+// *************************************************************************
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+// *************************************************************************
@@ -0,0 +1,188 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testChainCompression.cpp
+ * @brief   Unit test for ChainCompression
+ */
+
+#include <gtsam/slam/ChainCompression.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/Marginals.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+// *************************************************************************
+namespace example {
+// Square trajectory of 12 Pose2, with odometry between consecutive poses, a
+// loop closure between 11 and 0, and a prior on 0. The loop closure disagrees
+// a little with the odometry.
+const size_t n = 12;
+const noiseModel::Diagonal::shared_ptr odometryModel =
+    noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.05, 0.02));
+const SharedNoiseModel loopModel = noiseModel::Isotropic::Sigma(3, 0.1);
+
+Pose2 pose(size_t i) {
+  const size_t side = i / 3;
+  const Point2 corners[] = {Point2(0, 0), Point2(3, 0), Point2(3, 3), Point2(0, 3)};
+  const Point2 directions[] = {Point2(1, 0), Point2(0, 1), Point2(-1, 0), Point2(0, -1)};
+  return Pose2(M_PI / 2 * side, corners[side] + double(i % 3) * directions[side]);
+}
+
+NonlinearFactorGraph graph() {
+  NonlinearFactorGraph graph;
+  graph.addPrior(0, pose(0), noiseModel::Isotropic::Sigma(3, 0.01));
+  for (size_t i = 0; i + 1 < n; ++i)
+    graph.emplace_shared<BetweenFactor<Pose2> >(i, i + 1,
+        pose(i).between(pose(i + 1)), odometryModel);
+  graph.emplace_shared<BetweenFactor<Pose2> >(n - 1, 0,
+      pose(n - 1).between(pose(0)) * Pose2(0.1, -0.1, 0.05), loopModel);
+  return graph;
+}
+
+Values values() {
+  Values values;
+  for (size_t i = 0; i < n; ++i)
+    values.insert(i, pose(i));
+  return values;
+}
+}
+
+// *************************************************************************
+TEST(ChainCompression, compose) {
+  // Chain 1 -> 2 <- 3 with a factor pointing backwards
+  const Pose2 z12(1, 0.5, 0.3), z32(-0.5, 1, -0.2);
+  Matrix3 information = 100 * Matrix3::Identity();
+  information(0, 2) = information(2, 0) = 10;
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<BetweenFactor<Pose2> >(1, 2, z12, example::odometryModel);
+  graph.emplace_shared<BetweenFactor<Pose2> >(3, 2, z32,
+      noiseModel::Gaussian::Information(information));
+
+  ChainCompression<Pose2> compression(graph);
+  LONGS_EQUAL(1, compression.chains().size());
+  const ChainCompression<Pose2>::Chain& chain = compression.chains().front();
+  LONGS_EQUAL(1, chain.a);
+  LONGS_EQUAL(3, chain.b);
+  EXPECT(assert_container_equality(KeyVector({2}), chain.intermediates));
+  EXPECT(assert_equal(z12 * z32.inverse(), chain.measured, 1e-9));
+
+  // First-order covariance, see Lie.h for the Jacobians
+  Matrix3 H1, H2, Hinv;
+  const Pose2 z23 = z32.inverse(Hinv);
+  z12.compose(z23, H1, H2);
+  const Matrix3 expected = H1 * example::odometryModel->covariance() * H1.transpose()
+      + H2 * Hinv * information.inverse() * Hinv.transpose() * H2.transpose();
+  EXPECT(assert_equal(expected, chain.covariance, 1e-9));
+
+  // Reduced graph is a single factor with that covariance
+  LONGS_EQUAL(1, compression.graph().size());
+  EXPECT(compression.graph()[0]->equals(BetweenFactor<Pose2>(1, 3, chain.measured,
+      noiseModel::Gaussian::Covariance(expected)), 1e-9));
+}
+
+// *************************************************************************
+TEST(ChainCompression, keySets) {
+  NonlinearFactorGraph graph = example::graph();
+
+  // All of 1 to 11 are intermediate, but the chain ends where it starts
+  ChainCompression<Pose2> all(graph);
+  LONGS_EQUAL(0, all.chains().size());
+  LONGS_EQUAL(graph.size(), all.graph().size());
+
+  // Keep the corners
+  KeySet removable;
+  for (Key key = 1; key < 11; ++key)
+    if (key % 3 != 0)
+      removable.insert(key);
+  ChainCompression<Pose2> corners(graph, removable);
+  LONGS_EQUAL(4, corners.chains().size());
+  LONGS_EQUAL(6, corners.graph().size());
+  Values reduced = corners.reduce(example::values());
+  EXPECT(assert_container_equality(KeyVector({0, 3, 6, 9, 11}), reduced.keys()));
+
+  // Odometry measurements are exact, so expanding gives back all poses
+  EXPECT(assert_equal(example::values(), corners.expand(reduced), 1e-9));
+
+  // As is a cycle without other factors
+  NonlinearFactorGraph cycle;
+  for (size_t i = 0; i < 3; ++i)
+    cycle.emplace_shared<BetweenFactor<Pose2> >(i, (i + 1) % 3, Pose2(), example::odometryModel);
+  ChainCompression<Pose2> none(cycle);
+  LONGS_EQUAL(0, none.chains().size());
+  LONGS_EQUAL(3, none.graph().size());
+}
+
+// *************************************************************************
+TEST(ChainCompression, optimize) {
+  NonlinearFactorGraph graph = example::graph();
+  const Values initial = example::values();
+  const Values expected = LevenbergMarquardtOptimizer(graph, initial).optimize();
+
+  KeySet removable;
+  for (Key key = 1; key < 11; ++key)
+    if (key % 3 != 0)
+      removable.insert(key);
+  ChainCompression<Pose2> compression(graph, removable);
+  const Values reduced = LevenbergMarquardtOptimizer(compression.graph(),
+      compression.reduce(initial)).optimize();
+
+  // The kept poses agree with the full solution, and the intermediate poses
+  // are interpolated close to it
+  for (Key key : reduced.keys())
+    EXPECT(assert_equal(expected.at<Pose2>(key), reduced.at<Pose2>(key), 1e-4));
+  EXPECT(assert_equal(expected, compression.expand(reduced), 1e-3));
+
+  // Marginal covariance of a kept pose is the same to first order, the chains
+  // were composed at the measurements rather than at the solution
+  EXPECT(assert_equal(Marginals(graph, expected).marginalCovariance(6),
+      Marginals(compression.graph(), reduced).marginalCovariance(6), 1e-4));
+}
+
+// *************************************************************************
+TEST(ChainCompression, Pose3) {
+  // Exact odometry on a helix, with a loop closure between 0 and 5
+  NonlinearFactorGraph graph;
+  Values values;
+  const SharedNoiseModel model = noiseModel::Diagonal::Sigmas(
+      (Vector(6) << 0.01, 0.01, 0.02, 0.1, 0.1, 0.1).finished());
+  for (size_t i = 0; i < 10; ++i)
+    values.insert(i, Pose3(Rot3::Yaw(0.3 * i), Point3(cos(0.3 * i), sin(0.3 * i), 0.1 * i)));
+  graph.addPrior(0, values.at<Pose3>(0), model);
+  for (size_t i = 0; i < 9; ++i)
+    graph.emplace_shared<BetweenFactor<Pose3> >(i, i + 1,
+        values.at<Pose3>(i).between(values.at<Pose3>(i + 1)), model);
+  graph.emplace_shared<BetweenFactor<Pose3> >(0, 5,
+      values.at<Pose3>(0).between(values.at<Pose3>(5)), model);
+
+  // Chains 0-1-2-3-4-5 and 5-6-7-8-9
+  ChainCompression<Pose3> compression(graph);
+  LONGS_EQUAL(2, compression.chains().size());
+  EXPECT(assert_equal(values.at<Pose3>(0).between(values.at<Pose3>(5)),
+      compression.chains()[0].measured, 1e-9));
+  EXPECT(assert_equal(values.at<Pose3>(5).between(values.at<Pose3>(9)),
+      compression.chains()[1].measured, 1e-9));
+  LONGS_EQUAL(4, compression.graph().size());
+  EXPECT(assert_equal(values, compression.expand(compression.reduce(values)), 1e-9));
+}
+
+// *************************************************************************
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+// *************************************************************************
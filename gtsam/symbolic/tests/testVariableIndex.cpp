@@ -114,6 +114,30 @@ TEST(VariableIndex, remove) {
   CHECK(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(VariableIndex, renumberFactors) {
+
+  auto fg1 = testGraph1(), fg2 = testGraph2();
+
+  SymbolicFactorGraph fgCombined; fgCombined.push_back(fg1); fgCombined.push_back(fg2);
+
+  // Remove the factors of fg1, then renumber those of fg2 to start at zero
+  VariableIndex actual(fgCombined);
+  vector<size_t> indices;
+  indices.push_back(0); indices.push_back(1); indices.push_back(2); indices.push_back(3);
+  actual.remove(indices.begin(), indices.end(), fg1);
+  std::list<Key> unusedVariables; unusedVariables += 0, 9;
+  actual.removeUnusedVariables(unusedVariables.begin(), unusedVariables.end());
+
+  FactorIndices newIndices(fgCombined.size());
+  for (size_t i = fg1.size(); i < fgCombined.size(); ++i)
+    newIndices[i] = i - fg1.size();
+  actual.renumberFactors(newIndices, fg2.size());
+
+  VariableIndex expected(fg2);
+  CHECK(assert_equal(expected, actual));
+}
+
 /* ************************************************************************* */
 TEST(VariableIndex, deep_copy) {
 
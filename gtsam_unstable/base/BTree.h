@@ -237,15 +237,23 @@ namespace gtsam {
      *  Optimized non-recursive version as [find] is crucial for speed
      */
     const VALUE& find(const KEY& k) const {
+      const VALUE* value = lookup(k);
+      if (!value) throw std::invalid_argument("BTree::find: key not found");
+      return *value;
+    }
+
+    /**
+     *  find a value given a key, returns nullptr when not found
+     */
+    const VALUE* lookup(const KEY& k) const {
       const Node* node = root_.get();
       while (node) {
         const KEY& key = node->key();
         if      (k < key) node = node->left.root_.get();
         else if (key < k) node = node->right.root_.get();
-        else return node->value();
+        else return &node->value();
       }
-
-      throw std::invalid_argument("BTree::find: key not found");
+      return nullptr;
     }
 
     /** print in-order */
@@ -6,7 +6,6 @@
 
 #pragma once
 
-#include <gtsam/base/numericalDerivative.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam_unstable/dynamics/PoseRTV.h>
 
@@ -84,15 +83,27 @@ public:
   virtual Vector evaluateError(const PoseRTV& x1, const PoseRTV& x2,
       boost::optional<Matrix&> H1 = boost::none,
       boost::optional<Matrix&> H2 = boost::none) const {
-    Vector9 z;
-    z.head(3).operator=(accel_); // Strange syntax to work around ambiguous operator error with clang
-    z.segment(3, 3).operator=(gyro_); // Strange syntax to work around ambiguous operator error with clang
-    z.tail(3).operator=(x2.t()); // Strange syntax to work around ambiguous operator error with clang
-    if (H1) *H1 = numericalDerivative21<Vector9, PoseRTV, PoseRTV>(
-        boost::bind(This::predict_proxy, _1, _2, dt_), x1, x2, 1e-5);
-    if (H2) *H2 = numericalDerivative22<Vector9, PoseRTV, PoseRTV>(
-        boost::bind(This::predict_proxy, _1, _2, dt_), x1, x2, 1e-5);
-    return z - predict_proxy(x1, x2, dt_);
+    Matrix69 D_imu_x1, D_imu_x2;
+    Matrix39 D_t_x1, D_t_x2;
+    const Vector6 imu = x1.imuPrediction(x2, dt_, H1 ? &D_imu_x1 : 0,
+                                         H2 ? &D_imu_x2 : 0);
+    const Point3 t2 = x1.translationIntegration(x2, dt_, H1 ? &D_t_x1 : 0,
+                                                H2 ? &D_t_x2 : 0);
+    Vector9 error;
+    error << accel_ - imu.head<3>(), gyro_ - imu.tail<3>(), x2.t() - t2;
+    if (H1) {
+      Matrix9 D;
+      D << -D_imu_x1, -D_t_x1;
+      *H1 = D;
+    }
+    if (H2) {
+      // the measured translation is that of x2 itself
+      D_t_x2.block<3,3>(0,3) -= x2.R().matrix();
+      Matrix9 D;
+      D << -D_imu_x2, -D_t_x2;
+      *H2 = D;
+    }
+    return error;
   }
 
   /** dummy version that fails for non-dynamic poses */
@@ -102,16 +113,6 @@ public:
     assert(false);
     return Vector6::Zero();
   }
-
-private:
-
-  /** copy of the measurement function formulated for numerical derivatives */
-  static Vector9 predict_proxy(const PoseRTV& x1, const PoseRTV& x2, double dt) {
-    Vector9 hx;
-    hx.head(6).operator=(x1.imuPrediction(x2, dt)); // Strange syntax to work around ambiguous operator error with clang
-    hx.tail(3).operator=(x1.translationIntegration(x2, dt)); // Strange syntax to work around ambiguous operator error with clang
-    return hx;
-  }
 };
 
 } // \namespace gtsam
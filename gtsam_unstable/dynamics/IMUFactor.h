@@ -6,7 +6,6 @@
 
 #pragma once
 
-#include <gtsam/base/numericalDerivative.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam_unstable/dynamics/PoseRTV.h>
 
@@ -77,12 +76,12 @@ public:
   virtual Vector evaluateError(const PoseRTV& x1, const PoseRTV& x2,
       boost::optional<Matrix&> H1 = boost::none,
       boost::optional<Matrix&> H2 = boost::none) const {
-    const Vector6 meas = z();
-    if (H1) *H1 = numericalDerivative21<Vector6, PoseRTV, PoseRTV>(
-        boost::bind(This::predict_proxy, _1, _2, dt_, meas), x1, x2, 1e-5);
-    if (H2) *H2 = numericalDerivative22<Vector6, PoseRTV, PoseRTV>(
-        boost::bind(This::predict_proxy, _1, _2, dt_, meas), x1, x2, 1e-5);
-    return predict_proxy(x1, x2, dt_, meas);
+    Matrix69 D_hx_x1, D_hx_x2;
+    const Vector6 hx = x1.imuPrediction(x2, dt_, H1 ? &D_hx_x1 : 0,
+                                        H2 ? &D_hx_x2 : 0);
+    if (H1) *H1 = -D_hx_x1;
+    if (H2) *H2 = -D_hx_x2;
+    return z() - hx;
   }
 
   /** dummy version that fails for non-dynamic poses */
@@ -92,14 +91,6 @@ public:
     assert(false); // no corresponding factor here
     return Vector6::Zero();
   }
-
-private:
-  /** copy of the measurement function formulated for numerical derivatives */
-  static Vector6 predict_proxy(const PoseRTV& x1, const PoseRTV& x2,
-      double dt, const Vector6& meas) {
-    Vector6 hx = x1.imuPrediction(x2, dt);
-    return meas - hx;
-  }
 };
 
 } // \namespace gtsam
@@ -11,7 +11,7 @@ namespace gtsam {
 
 using namespace std;
 
-static const Vector kGravity = Vector::Unit(3,2)*9.81;
+static const Vector3 kGravity(0.0, 0.0, 9.81);
 
 /* ************************************************************************* */
 double bound(double a, double min, double max) {
@@ -65,7 +65,7 @@ PoseRTV PoseRTV::planarDynamics(double vel_rate, double heading_rate,
   const Velocity3& v1 = v();
 
   // Update vehicle heading
-  Rot3 r2 = r1.retract((Vector(3) << 0.0, 0.0, heading_rate * dt).finished());
+  Rot3 r2 = r1.retract(Vector3(0.0, 0.0, heading_rate * dt));
   const double yaw2 = r2.ypr()(0);
 
   // Update vehicle position
@@ -89,7 +89,7 @@ PoseRTV PoseRTV::flyingDynamics(
   const Velocity3& v1 = v();
 
   // Update vehicle heading (and normalise yaw)
-  Vector rot_rates = (Vector(3) << 0.0, pitch_rate, heading_rate).finished();
+  Vector3 rot_rates(0.0, pitch_rate, heading_rate);
   Rot3 r2 = r1.retract(rot_rates*dt);
 
   // Work out dynamics on platform
@@ -102,13 +102,13 @@ PoseRTV PoseRTV::flyingDynamics(
   double loss_lift = lift*std::abs(sin(pitch2));
   Rot3 yaw_correction_bn = Rot3::Yaw(yaw2);
   Point3 forward(forward_accel, 0.0, 0.0);
-  Vector Acc_n =
+  Vector3 Acc_n =
       yaw_correction_bn.rotate(forward)              // applies locally forward force in the global frame
-      - drag * (Vector(3) << v1.x(), v1.y(), 0.0).finished()  // drag term dependent on v1
-      + Vector::Unit(3,2)*(loss_lift - lift_control);                // falling due to lift lost from pitch
+      - drag * Vector3(v1.x(), v1.y(), 0.0)          // drag term dependent on v1
+      + Vector3::UnitZ()*(loss_lift - lift_control); // falling due to lift lost from pitch
 
   // Update Vehicle Position and Velocity
-  Velocity3 v2 = v1 + Velocity3(Acc_n * dt);
+  Velocity3 v2 = v1 + Acc_n * dt;
   Point3 t2 = translationIntegration(r2, v2, dt);
 
   return PoseRTV(r2, t2, v2);
@@ -116,12 +116,12 @@ PoseRTV PoseRTV::flyingDynamics(
 
 /* ************************************************************************* */
 PoseRTV PoseRTV::generalDynamics(
-    const Vector& accel, const Vector& gyro, double dt) const {
+    const Vector3& accel, const Vector3& gyro, double dt) const {
   //  Integrate Attitude Equations
   Rot3 r2 = rotation().retract(gyro * dt);
 
   //  Integrate Velocity Equations
-  Velocity3 v2 = velocity() + Velocity3(dt * (r2.matrix() * accel + kGravity));
+  Velocity3 v2 = velocity() + dt * (r2.rotate(accel) + kGravity);
 
   //  Integrate Position Equations
   Point3 t2 = translationIntegration(r2, v2, dt);
@@ -130,7 +130,8 @@ PoseRTV PoseRTV::generalDynamics(
 }
 
 /* ************************************************************************* */
-Vector6 PoseRTV::imuPrediction(const PoseRTV& x2, double dt) const {
+Vector6 PoseRTV::imuPrediction(const PoseRTV& x2, double dt,
+    OptionalJacobian<6,9> H1, OptionalJacobian<6,9> H2) const {
   // split out states
   const Rot3      &r1 = R(), &r2 = x2.R();
   const Velocity3 &v1 = v(), &v2 = x2.v();
@@ -139,13 +140,14 @@ Vector6 PoseRTV::imuPrediction(const PoseRTV& x2, double dt) const {
 
   // acceleration
   Vector3 accel = (v2-v1) / dt;
-  imu.head<3>() = r2.transpose() * (accel - kGravity);
+  Matrix3 D_accel_r2;
+  imu.head<3>() = r2.unrotate(accel - kGravity, H2 ? &D_accel_r2 : 0);
 
   // rotation rates
   // just using euler angles based on matlab code
   // FIXME: this is silly - we shouldn't use differences in Euler angles
-  Matrix Enb = RRTMnb(r1);
   Vector3 euler1 = r1.xyz(), euler2 = r2.xyz();
+  Matrix3 Enb = RRTMnb(euler1);
   Vector3 dR = euler2 - euler1;
 
   // normalize yaw in difference (as per Mitch's code)
@@ -154,6 +156,28 @@ Vector6 PoseRTV::imuPrediction(const PoseRTV& x2, double dt) const {
   imu.tail<3>() = Enb * dR;
 //  imu.tail(3) = r1.transpose() * dR;
 
+  // The euler angles of R*Expmap(w) change by RRTMbn(R)*w, and the retract of
+  // PoseRTV perturbs rotation and velocity as R*Expmap(w) and v+dv.
+  if (H1) {
+    // Enb also depends on roll and pitch of r1
+    const double s1 = sin(euler1.x()), c1 = cos(euler1.x());
+    const double s2 = sin(euler1.y()), c2 = cos(euler1.y());
+    Matrix3 D_gyro_euler1;
+    D_gyro_euler1 <<
+        0.0,                          -c2 * dR.z(),      0.0,
+        -s1 * dR.y() + c1 * c2 * dR.z(), -s1 * s2 * dR.z(), 0.0,
+        -c1 * dR.y() - s1 * c2 * dR.z(), -c1 * s2 * dR.z(), 0.0;
+    H1->setZero();
+    H1->block<3,3>(0,6) = -r2.transpose() / dt;
+    H1->block<3,3>(3,0) = D_gyro_euler1 * RRTMbn(euler1) - I_3x3 / dt;
+  }
+  if (H2) {
+    H2->setZero();
+    H2->block<3,3>(0,0) = D_accel_r2;
+    H2->block<3,3>(0,6) = r2.transpose() / dt;
+    H2->block<3,3>(3,0) = Enb * RRTMbn(euler2) / dt;
+  }
+
   return imu;
 }
 
@@ -165,6 +189,20 @@ Point3 PoseRTV::translationIntegration(const Rot3& r2, const Velocity3& v2, doub
   return pred_t2;
 }
 
+/* ************************************************************************* */
+Point3 PoseRTV::translationIntegration(const PoseRTV& x2, double dt,
+    OptionalJacobian<3,9> H1, OptionalJacobian<3,9> H2) const {
+  if (H1) {
+    H1->setZero();
+    H1->block<3,3>(0,3) = R().matrix();
+  }
+  if (H2) {
+    H2->setZero();
+    H2->block<3,3>(0,6) = dt * I_3x3;
+  }
+  return translationIntegration(x2.rotation(), x2.velocity(), dt);
+}
+
 /* ************************************************************************* */
 double PoseRTV::range(const PoseRTV& other,
     OptionalJacobian<1,9> H1, OptionalJacobian<1,9> H2) const {
@@ -205,11 +243,10 @@ PoseRTV PoseRTV::transformed_from(const Pose3& trans, ChartJacobian Dglobal,
 }
 
 /* ************************************************************************* */
-Matrix PoseRTV::RRTMbn(const Vector3& euler) {
-  assert(euler.size() == 3);
+Matrix3 PoseRTV::RRTMbn(const Vector3& euler) {
   const double s1 = sin(euler.x()), c1 = cos(euler.x());
   const double t2 = tan(euler.y()), c2 = cos(euler.y());
-  Matrix Ebn(3,3);
+  Matrix3 Ebn;
   Ebn << 1.0, s1 * t2, c1 * t2,
          0.0,      c1,     -s1,
          0.0, s1 / c2, c1 / c2;
@@ -217,13 +254,13 @@ Matrix PoseRTV::RRTMbn(const Vector3& euler) {
 }
 
 /* ************************************************************************* */
-Matrix PoseRTV::RRTMbn(const Rot3& att) {
+Matrix3 PoseRTV::RRTMbn(const Rot3& att) {
   return PoseRTV::RRTMbn(att.rpy());
 }
 
 /* ************************************************************************* */
-Matrix PoseRTV::RRTMnb(const Vector3& euler) {
-  Matrix Enb(3,3);
+Matrix3 PoseRTV::RRTMnb(const Vector3& euler) {
+  Matrix3 Enb;
   const double s1 = sin(euler.x()), c1 = cos(euler.x());
   const double s2 = sin(euler.y()), c2 = cos(euler.y());
   Enb << 1.0, 0.0,   -s2,
@@ -233,7 +270,7 @@ Matrix PoseRTV::RRTMnb(const Vector3& euler) {
 }
 
 /* ************************************************************************* */
-Matrix PoseRTV::RRTMnb(const Rot3& att) {
+Matrix3 PoseRTV::RRTMnb(const Rot3& att) {
   return PoseRTV::RRTMnb(att.rpy());
 }
 
@@ -105,12 +105,14 @@ public:
   PoseRTV flyingDynamics(double pitch_rate, double heading_rate, double lift_control, double dt) const;
 
   /// General Dynamics update - supply control inputs in body frame
-  PoseRTV generalDynamics(const Vector& accel, const Vector& gyro, double dt) const;
+  PoseRTV generalDynamics(const Vector3& accel, const Vector3& gyro, double dt) const;
 
   /// Dynamics predictor for both ground and flying robots, given states at 1 and 2
   /// Always move from time 1 to time 2
   /// @return imu measurement, as [accel, gyro]
-  Vector6 imuPrediction(const PoseRTV& x2, double dt) const;
+  Vector6 imuPrediction(const PoseRTV& x2, double dt,
+      OptionalJacobian<6,9> H1 = boost::none,
+      OptionalJacobian<6,9> H2 = boost::none) const;
 
   /// predict measurement and where Point3 for x2 should be, as a way
   /// of enforcing a velocity constraint
@@ -120,9 +122,9 @@ public:
   /// predict measurement and where Point3 for x2 should be, as a way
   /// of enforcing a velocity constraint
   /// This version takes a full PoseRTV, but ignores the existing translation for x2
-  inline Point3 translationIntegration(const PoseRTV& x2, double dt) const {
-    return translationIntegration(x2.rotation(), x2.velocity(), dt);
-  }
+  Point3 translationIntegration(const PoseRTV& x2, double dt,
+      OptionalJacobian<3,9> H1 = boost::none,
+      OptionalJacobian<3,9> H2 = boost::none) const;
 
   /// @return a vector for Matlab compatibility
   inline Vector translationIntegrationVec(const PoseRTV& x2, double dt) const {
@@ -146,13 +148,13 @@ public:
 
   /// RRTMbn - Function computes the rotation rate transformation matrix from
   /// body axis rates to euler angle (global) rates
-  static Matrix RRTMbn(const Vector3& euler);
-  static Matrix RRTMbn(const Rot3& att);
+  static Matrix3 RRTMbn(const Vector3& euler);
+  static Matrix3 RRTMbn(const Rot3& att);
 
   /// RRTMnb - Function computes the rotation rate transformation matrix from
   /// euler angle rates to body axis rates
-  static Matrix RRTMnb(const Vector3& euler);
-  static Matrix RRTMnb(const Rot3& att);
+  static Matrix3 RRTMnb(const Vector3& euler);
+  static Matrix3 RRTMnb(const Rot3& att);
   /// @}
 
 private:
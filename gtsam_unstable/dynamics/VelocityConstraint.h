@@ -6,7 +6,6 @@
 
 #pragma once
 
-#include <gtsam/base/numericalDerivative.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam_unstable/dynamics/PoseRTV.h>
 
@@ -83,11 +82,7 @@ public:
   virtual gtsam::Vector evaluateError(const PoseRTV& x1, const PoseRTV& x2,
       boost::optional<gtsam::Matrix&> H1=boost::none,
       boost::optional<gtsam::Matrix&> H2=boost::none) const {
-    if (H1) *H1 = gtsam::numericalDerivative21<gtsam::Vector,PoseRTV,PoseRTV>(
-        boost::bind(VelocityConstraint::evaluateError_, _1, _2, dt_, integration_mode_), x1, x2, 1e-5);
-    if (H2) *H2 = gtsam::numericalDerivative22<gtsam::Vector,PoseRTV,PoseRTV>(
-        boost::bind(VelocityConstraint::evaluateError_, _1, _2, dt_, integration_mode_), x1, x2, 1e-5);
-    return evaluateError_(x1, x2, dt_, integration_mode_);
+    return evaluateError_(x1, x2, dt_, integration_mode_, H1, H2);
   }
 
   virtual void print(const std::string& s = "", const gtsam::KeyFormatter& formatter = gtsam::DefaultKeyFormatter) const {
@@ -103,19 +98,32 @@ public:
   }
 
 private:
-  static gtsam::Vector evaluateError_(const PoseRTV& x1, const PoseRTV& x2,
-      double dt, const dynamics::IntegrationMode& mode) {
+  static Vector3 evaluateError_(const PoseRTV& x1, const PoseRTV& x2,
+      double dt, const dynamics::IntegrationMode& mode,
+      OptionalJacobian<3,9> H1 = boost::none,
+      OptionalJacobian<3,9> H2 = boost::none) {
 
-    const Velocity3& v1 = x1.v(), v2 = x2.v();
-    const Point3& p1 = x1.t(), p2 = x2.t();
-    Point3 hx(0,0,0);
+    // weights of the start and end velocities in the prediction
+    double w1 = 0.0, w2 = 0.0;
     switch(mode) {
-    case dynamics::TRAPEZOIDAL: hx = p1 + Point3((v1 + v2) * dt *0.5); break;
-    case dynamics::EULER_START: hx = p1 + Point3(v1 * dt); break;
-    case dynamics::EULER_END  : hx = p1 + Point3(v2 * dt); break;
+    case dynamics::TRAPEZOIDAL: w1 = w2 = 0.5; break;
+    case dynamics::EULER_START: w1 = 1.0; break;
+    case dynamics::EULER_END  : w2 = 1.0; break;
     default: assert(false); break;
     }
-    return p2 - hx;
+
+    // translations are perturbed in the body frame, velocities in the global frame
+    if (H1) {
+      H1->setZero();
+      H1->block<3,3>(0,3) = -x1.R().matrix();
+      H1->block<3,3>(0,6) = -w1 * dt * I_3x3;
+    }
+    if (H2) {
+      H2->setZero();
+      H2->block<3,3>(0,3) = x2.R().matrix();
+      H2->block<3,3>(0,6) = -w2 * dt * I_3x3;
+    }
+    return x2.t() - x1.t() - dt * (w1 * x1.v() + w2 * x2.v());
   }
 };
 
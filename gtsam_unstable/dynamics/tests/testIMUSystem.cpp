@@ -14,6 +14,7 @@
 #include <gtsam/nonlinear/NonlinearEquality.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/base/numericalDerivative.h>
 
 #include <gtsam_unstable/dynamics/IMUFactor.h>
 #include <gtsam_unstable/dynamics/FullIMUFactor.h>
@@ -51,6 +52,29 @@ TEST(testIMUSystem, instantiations) {
   VelocityPrior velPrior(x1, Vector::Ones(3), model3);
 }
 
+/* ************************************************************************* */
+TEST( testIMUSystem, jacobians ) {
+  const double dt = 0.1;
+  PoseRTV xA(Point3(0.5, 0.2, 0.1), Rot3::RzRyRx(0.1, 0.2, 0.3), Velocity3(1.0, 0.5, 0.2));
+  PoseRTV xB(Point3(0.6, 0.2, 0.1), Rot3::RzRyRx(0.12, 0.18, 0.33), Velocity3(0.9, 0.6, 0.2));
+  Vector3 accel(0.1, 0.2, 9.9), gyro(0.2, -0.1, 0.3);
+  Matrix actH1, actH2;
+
+  IMUFactor<PoseRTV> imu(accel, gyro, dt, x1, x2, noiseModel::Unit::Create(6));
+  boost::function<Vector(const PoseRTV&, const PoseRTV&)> f =
+      [&](const PoseRTV& a, const PoseRTV& b) { return imu.evaluateError(a, b); };
+  imu.evaluateError(xA, xB, actH1, actH2);
+  EXPECT(assert_equal(numericalDerivative21(f, xA, xB), actH1, tol));
+  EXPECT(assert_equal(numericalDerivative22(f, xA, xB), actH2, tol));
+
+  FullIMUFactor<PoseRTV> full_imu(accel, gyro, dt, x1, x2, noiseModel::Unit::Create(9));
+  boost::function<Vector(const PoseRTV&, const PoseRTV&)> full_f =
+      [&](const PoseRTV& a, const PoseRTV& b) { return full_imu.evaluateError(a, b); };
+  full_imu.evaluateError(xA, xB, actH1, actH2);
+  EXPECT(assert_equal(numericalDerivative21(full_f, xA, xB), actH1, tol));
+  EXPECT(assert_equal(numericalDerivative22(full_f, xA, xB), actH2, tol));
+}
+
 /* ************************************************************************* */
 TEST( testIMUSystem, optimize_chain ) {
   // create a simple chain of poses to generate IMU measurements
@@ -184,6 +184,40 @@ TEST( testPoseRTV, range ) {
   EXPECT(assert_equal(numericH2, actH2));
 }
 
+/* ************************************************************************* */
+Vector6 imuPrediction_proxy(const PoseRTV& x1, const PoseRTV& x2) {
+  return x1.imuPrediction(x2, 0.1);
+}
+TEST( testPoseRTV, imuPrediction ) {
+  PoseRTV x1(pt, rot, vel);
+  PoseRTV x2(Point3(1.1, 2.0, 3.1), Rot3::RzRyRx(0.15, 0.18, 0.35), Velocity3(0.5, 0.4, 0.7));
+
+  Matrix actH1, actH2;
+  Vector6 actual = x1.imuPrediction(x2, 0.1, actH1, actH2);
+  EXPECT(assert_equal(x1.imuPrediction(x2, 0.1), actual));
+  Matrix numericH1 = numericalDerivative21(imuPrediction_proxy, x1, x2);
+  Matrix numericH2 = numericalDerivative22(imuPrediction_proxy, x1, x2);
+  EXPECT(assert_equal(numericH1, actH1, 1e-6));
+  EXPECT(assert_equal(numericH2, actH2, 1e-6));
+}
+
+/* ************************************************************************* */
+Point3 translationIntegration_proxy(const PoseRTV& x1, const PoseRTV& x2) {
+  return x1.translationIntegration(x2, 0.1);
+}
+TEST( testPoseRTV, translationIntegration ) {
+  PoseRTV x1(pt, rot, vel);
+  PoseRTV x2(Point3(1.1, 2.0, 3.1), Rot3::RzRyRx(0.15, 0.18, 0.35), Velocity3(0.5, 0.4, 0.7));
+
+  Matrix actH1, actH2;
+  EXPECT(assert_equal(Point3(pt + 0.1 * x2.v()),
+      x1.translationIntegration(x2, 0.1, actH1, actH2)));
+  Matrix numericH1 = numericalDerivative21(translationIntegration_proxy, x1, x2);
+  Matrix numericH2 = numericalDerivative22(translationIntegration_proxy, x1, x2);
+  EXPECT(assert_equal(numericH1, actH1));
+  EXPECT(assert_equal(numericH2, actH2));
+}
+
 /* ************************************************************************* */
 PoseRTV transformed_from_proxy(const PoseRTV& a, const Pose3& trans) {
   return a.transformed_from(trans);
@@ -227,15 +261,15 @@ TEST( testPoseRTV, transformed_from_2 ) {
 
 /* ************************************************************************* */
 TEST(testPoseRTV, RRTMbn) {
-  EXPECT(assert_equal(I_3x3, PoseRTV::RRTMbn(kZero3)));
-  EXPECT(assert_equal(I_3x3, PoseRTV::RRTMbn(Rot3())));
+  EXPECT(assert_equal((Matrix3)I_3x3, PoseRTV::RRTMbn(kZero3)));
+  EXPECT(assert_equal((Matrix3)I_3x3, PoseRTV::RRTMbn(Rot3())));
   EXPECT(assert_equal(PoseRTV::RRTMbn(Vector3(0.3, 0.2, 0.1)), PoseRTV::RRTMbn(Rot3::Ypr(0.1, 0.2, 0.3))));
 }
 
 /* ************************************************************************* */
 TEST(testPoseRTV, RRTMnb) {
-  EXPECT(assert_equal(I_3x3, PoseRTV::RRTMnb(kZero3)));
-  EXPECT(assert_equal(I_3x3, PoseRTV::RRTMnb(Rot3())));
+  EXPECT(assert_equal((Matrix3)I_3x3, PoseRTV::RRTMnb(kZero3)));
+  EXPECT(assert_equal((Matrix3)I_3x3, PoseRTV::RRTMnb(Rot3())));
   EXPECT(assert_equal(PoseRTV::RRTMnb(Vector3(0.3, 0.2, 0.1)), PoseRTV::RRTMnb(Rot3::Ypr(0.1, 0.2, 0.3))));
 }
 
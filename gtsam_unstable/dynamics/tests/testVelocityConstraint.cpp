@@ -6,6 +6,7 @@
 #include <CppUnitLite/TestHarness.h>
 
 #include <gtsam_unstable/dynamics/VelocityConstraint.h>
+#include <gtsam/base/numericalDerivative.h>
 
 using namespace gtsam;
 
@@ -55,6 +56,24 @@ TEST( testEulerVelocityConstraint, euler_end ) {
   EXPECT(assert_equal(Vector::Unit(3,0)*0.5, constraint.evaluateError(origin, pose1a), tol));
 }
 
+/* ************************************************************************* */
+TEST( testVelocityConstraint, jacobians ) {
+  PoseRTV xA(Point3(0.5, 0.2, 0.1), Rot3::RzRyRx(0.1, 0.2, 0.3), Velocity3(1.0, 0.5, 0.2));
+  PoseRTV xB(Point3(1.5, 0.7, 0.0), Rot3::RzRyRx(0.2, 0.1, 0.4), Velocity3(0.8, 0.3, 0.1));
+  dynamics::IntegrationMode modes[] = {
+      dynamics::TRAPEZOIDAL, dynamics::EULER_START, dynamics::EULER_END};
+  for (dynamics::IntegrationMode mode : modes) {
+    VelocityConstraint constraint(x1, x2, mode, dt);
+    boost::function<Vector(const PoseRTV&, const PoseRTV&)> f =
+        [&](const PoseRTV& a, const PoseRTV& b) { return constraint.evaluateError(a, b); };
+
+    Matrix actH1, actH2;
+    constraint.evaluateError(xA, xB, actH1, actH2);
+    EXPECT(assert_equal(numericalDerivative21(f, xA, xB), actH1, tol));
+    EXPECT(assert_equal(numericalDerivative22(f, xA, xB), actH2, tol));
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
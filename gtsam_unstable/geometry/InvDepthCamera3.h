@@ -18,7 +18,7 @@
 #include <gtsam/base/Matrix.h>
 #include <gtsam/geometry/Point2.h>
 #include <gtsam/geometry/Pose3.h>
-#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/PinholePose.h>
 
 namespace gtsam {
 
@@ -92,18 +92,15 @@ public:
     gtsam::Point3 m(cos(theta)*cos(phi),sin(theta)*cos(phi),sin(phi));
     const gtsam::Point3 landmark = ray_base + m/rho;
 
-    gtsam::PinholeCamera<CALIBRATION> camera(pose_, *k_);
+    gtsam::PinholePose<CALIBRATION> camera(pose_, k_);
 
     if (!H1 && !H2 && !H3) {
       gtsam::Point2 uv= camera.project(landmark);
       return uv;
     }
     else {
-      gtsam::Matrix J2;
-      gtsam::Point2 uv= camera.project(landmark,H1, J2, boost::none);
-      if (H1) {
-        *H1 = (*H1) * I_6x6;
-      }
+      gtsam::Matrix23 J2;
+      gtsam::Point2 uv= camera.project(landmark, H1, J2);
 
       double cos_theta = cos(theta);
       double sin_theta = sin(theta);
@@ -112,37 +109,16 @@ public:
       double rho2 = rho * rho;
 
       if (H2) {
-        double H11 = 1;
-        double H12 = 0;
-        double H13 = 0;
-        double H14 = -cos_phi*sin_theta/rho;
-        double H15 = -cos_theta*sin_phi/rho;
-
-        double H21 = 0;
-        double H22 = 1;
-        double H23 = 0;
-        double H24 = cos_phi*cos_theta/rho;
-        double H25 = -sin_phi*sin_theta/rho;
-
-        double H31 = 0;
-        double H32 = 0;
-        double H33 = 1;
-        double H34 = 0;
-        double H35 = cos_phi/rho;
-
-        *H2 = J2 * (Matrix(3, 5) <<
-            H11, H12, H13, H14, H15,
-            H21, H22, H23, H24, H25,
-            H31, H32, H33, H34, H35).finished();
+        gtsam::Matrix35 J_landmark;
+        J_landmark << 1, 0, 0, -cos_phi*sin_theta/rho, -cos_theta*sin_phi/rho,
+                      0, 1, 0,  cos_phi*cos_theta/rho, -sin_phi*sin_theta/rho,
+                      0, 0, 1,                      0,            cos_phi/rho;
+        *H2 = J2 * J_landmark;
       }
       if(H3) {
-        double H16 = -cos_phi*cos_theta/rho2;
-        double H26 = -cos_phi*sin_theta/rho2;
-        double H36 = -sin_phi/rho2;
-        *H3 = J2 * (Matrix(3, 1) <<
-            H16,
-            H26,
-            H36).finished();
+        *H3 = J2 * gtsam::Vector3(-cos_phi*cos_theta/rho2,
+                                  -cos_phi*sin_theta/rho2,
+                                  -sin_phi/rho2);
       }
       return uv;
     }
@@ -0,0 +1,180 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PersistentValues.cpp
+ * @brief   Values stored in a persistent balanced tree, with O(1) copies
+ */
+
+#include <gtsam_unstable/nonlinear/PersistentValues.h>
+
+#include <iostream>
+#include <typeinfo>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+typedef PersistentValues::Tree Tree;
+typedef Tree::value_type KeyValue;
+
+/// Build a balanced tree from key-sorted pairs [begin, end) in linear time
+Tree BuildBalanced(vector<KeyValue>::const_iterator begin,
+                   vector<KeyValue>::const_iterator end) {
+  if (begin == end) return Tree();
+  vector<KeyValue>::const_iterator middle = begin + (end - begin) / 2;
+  return Tree(BuildBalanced(begin, middle), *middle,
+              BuildBalanced(middle + 1, end));
+}
+
+/// Take ownership of a value allocated by clone_() or retract_()
+PersistentValues::SharedValue Own(const Value* value) {
+  return PersistentValues::SharedValue(
+      value, [](const Value* v) { v->deallocate_(); });
+}
+}  // namespace
+
+/* ************************************************************************* */
+PersistentValues::PersistentValues(const Values& values) : size_(values.size()) {
+  vector<KeyValue> sorted;
+  sorted.reserve(values.size());
+  for (const auto& key_value : values)
+    sorted.push_back(KeyValue(key_value.key, Own(key_value.value.clone_())));
+  tree_ = BuildBalanced(sorted.begin(), sorted.end());
+}
+
+/* ************************************************************************* */
+Values PersistentValues::values() const {
+  Values result;
+  for (const KeyValue& key_value : tree_)
+    result.insert(key_value.first, *key_value.second);
+  return result;
+}
+
+/* ************************************************************************* */
+void PersistentValues::print(const string& str,
+                             const KeyFormatter& keyFormatter) const {
+  cout << str << "PersistentValues with " << size() << " values:" << endl;
+  for (const KeyValue& key_value : tree_) {
+    cout << "Value " << keyFormatter(key_value.first) << ": ";
+    key_value.second->print("");
+    cout << "\n";
+  }
+}
+
+/* ************************************************************************* */
+bool PersistentValues::equals(const PersistentValues& other, double tol) const {
+  if (size() != other.size()) return false;
+  if (same(other)) return true;
+  for (const_iterator it1 = begin(), it2 = other.begin(); it1 != end();
+       ++it1, ++it2) {
+    const Value& value1 = *it1->second;
+    const Value& value2 = *it2->second;
+    if (typeid(value1) != typeid(value2) || it1->first != it2->first ||
+        !value1.equals_(value2, tol))
+      return false;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+const Value* PersistentValues::find(Key j) const {
+  const SharedValue* value = tree_.lookup(j);
+  return value ? value->get() : nullptr;
+}
+
+/* ************************************************************************* */
+const Value& PersistentValues::at(Key j) const {
+  const Value* value = find(j);
+  if (!value) throw ValuesKeyDoesNotExist("retrieve", j);
+  return *value;
+}
+
+/* ************************************************************************* */
+void PersistentValues::insert(Key j, const Value& val) {
+  if (exists(j)) throw ValuesKeyAlreadyExists(j);
+  tree_ = tree_.add(j, Own(val.clone_()));
+  ++size_;
+}
+
+/* ************************************************************************* */
+void PersistentValues::update(Key j, const Value& val) {
+  const Value* old_value = find(j);
+  if (!old_value) throw ValuesKeyDoesNotExist("update", j);
+  if (typeid(*old_value) != typeid(val))
+    throw ValuesIncorrectType(j, typeid(*old_value), typeid(val));
+  tree_ = tree_.add(j, Own(val.clone_()));
+}
+
+/* ************************************************************************* */
+void PersistentValues::erase(Key j) {
+  if (!exists(j)) throw ValuesKeyDoesNotExist("erase", j);
+  tree_ = tree_.remove(j);
+  --size_;
+}
+
+/* ************************************************************************* */
+KeyVector PersistentValues::keys() const {
+  KeyVector result;
+  result.reserve(size());
+  for (const KeyValue& key_value : tree_) result.push_back(key_value.first);
+  return result;
+}
+
+/* ************************************************************************* */
+size_t PersistentValues::dim() const {
+  size_t result = 0;
+  for (const KeyValue& key_value : tree_) result += key_value.second->dim();
+  return result;
+}
+
+/* ************************************************************************* */
+PersistentValues PersistentValues::retract(const VectorValues& delta) const {
+  PersistentValues result(*this);
+
+  // Path copying costs O(log n) per key, rebuilding O(n) for all keys
+  if (delta.size() * (tree_.height() + 1) < size()) {
+    for (const VectorValues::KeyValuePair& key_delta : delta) {
+      const Value* value = find(key_delta.first);
+      if (value)
+        result.tree_ =
+            result.tree_.add(key_delta.first, Own(value->retract_(key_delta.second)));
+    }
+  } else {
+    vector<KeyValue> sorted;
+    sorted.reserve(size());
+    for (const KeyValue& key_value : tree_) {
+      VectorValues::const_iterator it = delta.find(key_value.first);
+      if (it != delta.end())
+        sorted.push_back(
+            KeyValue(key_value.first, Own(key_value.second->retract_(it->second))));
+      else
+        sorted.push_back(key_value);
+    }
+    result.tree_ = BuildBalanced(sorted.begin(), sorted.end());
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+VectorValues PersistentValues::localCoordinates(const PersistentValues& cp) const {
+  if (size() != cp.size()) throw DynamicValuesMismatched();
+  VectorValues result;
+  for (const_iterator it1 = begin(), it2 = cp.begin(); it1 != end();
+       ++it1, ++it2) {
+    if (it1->first != it2->first) throw DynamicValuesMismatched();
+    result.insert(it1->first, it1->second->localCoordinates_(*it2->second));
+  }
+  return result;
+}
+
+}  // namespace gtsam
@@ -0,0 +1,151 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PersistentValues.h
+ * @brief   Values stored in a persistent balanced tree, with O(1) copies
+ */
+
+#pragma once
+
+#include <gtsam_unstable/dllexport.h>
+#include <gtsam_unstable/base/BTree.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+/**
+ * A collection of values like Values, but stored in an immutable, structurally
+ * shared BTree.  Copying a PersistentValues is O(1), and insert, update and
+ * erase copy only the O(log n) tree nodes on the path to the changed key, the
+ * value objects themselves are shared between all copies.  This makes it
+ * cheap to keep snapshots, e.g., of trial steps or of estimates handed to
+ * concurrent readers.  retract() only creates new value objects for the keys
+ * in the delta.
+ *
+ * The interface follows Values, and errors are reported with the same
+ * exceptions.  Convert with the constructor and values() where a Values is
+ * needed.
+ */
+class GTSAM_UNSTABLE_EXPORT PersistentValues {
+ public:
+  typedef boost::shared_ptr<const Value> SharedValue;
+  typedef BTree<Key, SharedValue> Tree;
+  typedef Tree::const_iterator const_iterator;
+
+ private:
+  Tree tree_;
+  size_t size_;  ///< cached, as BTree::size() traverses the tree
+
+  /// Lookup that returns nullptr if the key does not exist
+  const Value* find(Key j) const;
+
+ public:
+  /// Default constructor creates an empty PersistentValues
+  PersistentValues() : size_(0) {}
+
+  /// Copy all values, in O(n) as they are inserted in order
+  explicit PersistentValues(const Values& values);
+
+  /// Deep copy into a Values
+  Values values() const;
+
+  /// @name Testable
+  /// @{
+
+  /** print method for testing and debugging */
+  void print(const std::string& str = "",
+             const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /** Test whether the sets of keys and values are identical */
+  bool equals(const PersistentValues& other, double tol = 1e-9) const;
+
+  /// @}
+
+  /// The number of variables
+  size_t size() const { return size_; }
+
+  /// whether the config is empty
+  bool empty() const { return size_ == 0; }
+
+  /** Check if a value exists with key \c j */
+  bool exists(Key j) const { return tree_.mem(j); }
+
+  /** Retrieve a variable by key \c j, throws ValuesKeyDoesNotExist if it does
+   * not exist */
+  const Value& at(Key j) const;
+
+  /** Retrieve a variable by key \c j, throws ValuesKeyDoesNotExist if it does
+   * not exist and ValuesIncorrectType if it has another type */
+  template <typename ValueType>
+  ValueType at(Key j) const {
+    const Value* value = find(j);
+    if (!value) throw ValuesKeyDoesNotExist("at", j);
+    auto h = internal::handle<ValueType>();
+    return h(j, value);
+  }
+
+  /** Add a variable with the given j, throws ValuesKeyAlreadyExists if j is
+   * already present */
+  void insert(Key j, const Value& val);
+
+  /** Templated version to add a variable with the given j */
+  template <typename ValueType>
+  void insert(Key j, const ValueType& val) {
+    insert(j, static_cast<const Value&>(GenericValue<ValueType>(val)));
+  }
+
+  /** single element change of existing element, throws ValuesKeyDoesNotExist
+   * if it does not exist and ValuesIncorrectType if the type differs */
+  void update(Key j, const Value& val);
+
+  /** Templated version to update a variable with the given j */
+  template <typename ValueType>
+  void update(Key j, const ValueType& val) {
+    update(j, static_cast<const Value&>(GenericValue<ValueType>(val)));
+  }
+
+  /** Remove a variable, throws ValuesKeyDoesNotExist if it does not exist */
+  void erase(Key j);
+
+  /** Returns a vector of keys in the config, in increasing order */
+  KeyVector keys() const;
+
+  /** Sum of the dimensions of all variables */
+  size_t dim() const;
+
+  /** Add a delta config to current config and returns a new config, values
+   * of variables not in the delta are shared */
+  PersistentValues retract(const VectorValues& delta) const;
+
+  /** Get a delta config about a linearization point c0 (*this) */
+  VectorValues localCoordinates(const PersistentValues& cp) const;
+
+  /** Whether two PersistentValues share their whole tree, e.g. after a copy */
+  bool same(const PersistentValues& other) const {
+    return tree_.same(other.tree_);
+  }
+
+  /// Iterator over (key, shared value) pairs in increasing key order
+  const_iterator begin() const { return tree_.begin(); }
+
+  /// End iterator
+  const_iterator end() const { return tree_.end(); }
+};
+
+/// traits
+template <>
+struct traits<PersistentValues> : public Testable<PersistentValues> {};
+
+}  // namespace gtsam
@@ -0,0 +1,105 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testPersistentValues.cpp
+ * @brief   Unit tests for PersistentValues
+ */
+
+#include <gtsam_unstable/nonlinear/PersistentValues.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Point3.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::L;
+using symbol_shorthand::X;
+
+/* ************************************************************************* */
+Values createValues() {
+  Values values;
+  for (size_t i = 0; i < 20; i++)
+    values.insert(X(i), Pose2(i, 0.1 * i, 0.01 * i));
+  values.insert(L(1), Point3(1, 2, 3));
+  return values;
+}
+
+/* ************************************************************************* */
+TEST(PersistentValues, conversion) {
+  Values expected = createValues();
+  PersistentValues values(expected);
+  EXPECT_LONGS_EQUAL(21, values.size());
+  EXPECT_LONGS_EQUAL(63, values.dim());
+  EXPECT(assert_equal(expected, values.values()));
+  EXPECT(expected.keys() == values.keys());
+  EXPECT(assert_equal(Pose2(3, 0.3, 0.03), values.at<Pose2>(X(3))));
+  EXPECT(assert_equal(Point3(1, 2, 3), values.at<Point3>(L(1))));
+  CHECK_EXCEPTION(values.at<Pose2>(L(1)), ValuesIncorrectType);
+  CHECK_EXCEPTION(values.at(X(30)), ValuesKeyDoesNotExist);
+}
+
+/* ************************************************************************* */
+TEST(PersistentValues, snapshots) {
+  PersistentValues values(createValues());
+
+  // Copies share the tree, changes are not visible in the snapshot
+  PersistentValues snapshot(values);
+  EXPECT(snapshot.same(values));
+  values.update(X(3), Pose2(3, 3, 3));
+  values.insert(X(30), Pose2(30, 0, 0));
+  values.erase(L(1));
+  EXPECT(!snapshot.same(values));
+
+  EXPECT(assert_equal(Pose2(3, 3, 3), values.at<Pose2>(X(3))));
+  EXPECT(assert_equal(Pose2(3, 0.3, 0.03), snapshot.at<Pose2>(X(3))));
+  EXPECT(values.exists(X(30)) && !snapshot.exists(X(30)));
+  EXPECT(!values.exists(L(1)) && snapshot.exists(L(1)));
+  EXPECT_LONGS_EQUAL(21, values.size());
+  EXPECT(assert_equal(createValues(), snapshot.values()));
+
+  CHECK_EXCEPTION(values.insert(X(3), Pose2()), ValuesKeyAlreadyExists);
+  CHECK_EXCEPTION(values.update(X(3), Point3()), ValuesIncorrectType);
+  CHECK_EXCEPTION(values.erase(L(1)), ValuesKeyDoesNotExist);
+}
+
+/* ************************************************************************* */
+TEST(PersistentValues, retract) {
+  Values expected = createValues();
+  PersistentValues values(expected);
+
+  // Few keys, retracted by path copying
+  VectorValues delta;
+  delta.insert(X(5), Vector3(0.1, 0.2, 0.3));
+  PersistentValues actual = values.retract(delta);
+  EXPECT(assert_equal(expected.retract(delta), actual.values()));
+  EXPECT(assert_equal(expected.localCoordinates(expected.retract(delta)),
+                      values.localCoordinates(actual)));
+
+  // All keys, the tree is rebuilt
+  for (size_t i = 0; i < 20; i++)
+    if (i != 5) delta.insert(X(i), Vector3(0.01 * i, 0, -0.02));
+  delta.insert(L(1), Vector3(1, 1, 1));
+  actual = values.retract(delta);
+  EXPECT(assert_equal(expected.retract(delta), actual.values()));
+  EXPECT(assert_equal(expected.localCoordinates(expected.retract(delta)),
+                      values.localCoordinates(actual)));
+  EXPECT(assert_equal(expected, values.values()));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -154,13 +154,14 @@ public:
 
     Matrix H1, H2;
 
-    T hx = p1.between(p2, H1, H2); // h(x)
+    // Jacobians are only needed when linearizing
+    T hx = H ? p1.between(p2, H1, H2) : p1.between(p2); // h(x)
     // manifold equivalent of h(x)-z -> log(z,h(x))
 
     Vector err = measured_.localCoordinates(hx);
 
     // Calculate indicator probabilities (inlier and outlier)
-    Vector p_inlier_outlier = calcIndicatorProb(x);
+    Vector p_inlier_outlier = calcIndicatorProb(x, err);
     double p_inlier = p_inlier_outlier[0];
     double p_outlier = p_inlier_outlier[1];
 
@@ -231,10 +232,16 @@ public:
   /* ************************************************************************* */
   Vector calcIndicatorProb(const Values& x) const {
 
-    bool debug = false;
-
     Vector err = unwhitenedError(x);
 
+    return this->calcIndicatorProb(x, err);
+  }
+
+  /* ************************************************************************* */
+  Vector calcIndicatorProb(const Values& x, const Vector& err) const {
+
+    bool debug = false;
+
     // Calculate indicator probabilities (inlier and outlier)
     Vector err_wh_inlier = model_inlier_->whiten(err);
     Vector err_wh_outlier = model_outlier_->whiten(err);
@@ -290,9 +297,7 @@ public:
     const T& p1 = x.at<T>(key1_);
     const T& p2 = x.at<T>(key2_);
 
-    Matrix H1, H2;
-
-    T hx = p1.between(p2, H1, H2); // h(x)
+    T hx = p1.between(p2); // h(x)
 
     return measured_.localCoordinates(hx);
   }
@@ -0,0 +1,114 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BetweenFactorMixture.h
+ * @brief   Between factor with a mixture of noise models, e.g. inlier/outlier
+ */
+
+#pragma once
+
+#include <gtsam_unstable/slam/MixtureFactor.h>
+#include <gtsam/base/Testable.h>
+#include <gtsam/base/Lie.h>
+
+namespace gtsam {
+
+/**
+ * A between measurement explained by a mixture of Gaussian noise models.  With
+ * an inlier and an outlier model and mode EM this computes the same weights
+ * as BetweenFactorEM, but evaluates between() and its Jacobians only once per
+ * linearization.
+ * @tparam VALUE the Value type
+ */
+template <class VALUE>
+class BetweenFactorMixture : public MixtureFactor {
+ public:
+  typedef VALUE T;
+
+ private:
+  typedef BetweenFactorMixture<VALUE> This;
+  typedef MixtureFactor Base;
+
+  VALUE measured_;  ///< The measurement
+
+  /** concept check by type */
+  BOOST_CONCEPT_ASSERT((IsLieGroup<T>));
+
+ public:
+  typedef boost::shared_ptr<BetweenFactorMixture> shared_ptr;
+
+  /// Default constructor for serialization
+  BetweenFactorMixture() {}
+
+  /// Constructor, see MixtureFactor for the meaning of the arguments
+  BetweenFactorMixture(Key key1, Key key2, const VALUE& measured,
+                       const std::vector<SharedGaussian>& models,
+                       const Vector& priors, Mode mode = EM,
+                       double minWeight = 0.0)
+      : Base(KeyVector{key1, key2}, models, priors, mode, minWeight),
+        measured_(measured) {}
+
+  virtual ~BetweenFactorMixture() {}
+
+  /// @return a deep copy of this factor
+  virtual NonlinearFactor::shared_ptr clone() const {
+    return boost::static_pointer_cast<NonlinearFactor>(
+        NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// @name Testable
+  /// @{
+
+  virtual void print(const std::string& s = "",
+                     const KeyFormatter& keyFormatter = DefaultKeyFormatter) const {
+    std::cout << s << "BetweenFactorMixture(" << keyFormatter(keys_[0]) << ","
+              << keyFormatter(keys_[1]) << ")\n";
+    traits<T>::Print(measured_, "  measured: ");
+    Base::print("  ", keyFormatter);
+  }
+
+  virtual bool equals(const NonlinearFactor& f, double tol = 1e-9) const {
+    const This* e = dynamic_cast<const This*>(&f);
+    return e && Base::equals(f, tol) &&
+           traits<T>::Equals(measured_, e->measured_, tol);
+  }
+
+  /// @}
+
+  /// The residual Local(measured, between(p1, p2)), as in BetweenFactor
+  virtual Vector unwhitenedError(
+      const Values& x,
+      boost::optional<std::vector<Matrix>&> H = boost::none) const {
+    const T& p1 = x.at<T>(keys_[0]);
+    const T& p2 = x.at<T>(keys_[1]);
+    T hx;
+    if (H) {
+      Matrix H1, H2;
+      hx = traits<T>::Between(p1, p2, H1, H2);
+      (*H)[0] = H1;
+      (*H)[1] = H2;
+    } else {
+      hx = traits<T>::Between(p1, p2);
+    }
+    return traits<T>::Local(measured_, hx);
+  }
+
+  /// return the measured
+  const VALUE& measured() const { return measured_; }
+};
+
+/// traits
+template <class VALUE>
+struct traits<BetweenFactorMixture<VALUE> >
+    : public Testable<BetweenFactorMixture<VALUE> > {};
+
+}  // namespace gtsam
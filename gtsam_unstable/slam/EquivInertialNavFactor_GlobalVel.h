@@ -304,48 +304,86 @@ public:
       boost::optional<Matrix&> H4 = boost::none,
       boost::optional<Matrix&> H5 = boost::none) const {
 
-    // TODO: Write analytical derivative calculations
-    // Jacobian w.r.t. Pose1
-    if (H1){
-      Matrix H1_Pose = numericalDerivative11<POSE, POSE>(boost::bind(&EquivInertialNavFactor_GlobalVel::evaluatePoseError, this, _1, Vel1, Bias1, Pose2, Vel2), Pose1);
-      Matrix H1_Vel = numericalDerivative11<VELOCITY, POSE>(boost::bind(&EquivInertialNavFactor_GlobalVel::evaluateVelocityError, this, _1, Vel1, Bias1, Pose2, Vel2), Pose1);
-      *H1 = stack(2, &H1_Pose, &H1_Vel);
+    // Pre-integrated deltas corrected for (Bias1 - Bias_t0), as in predictPose
+    // and predictVelocity
+    Vector3 delta_BiasAcc  = Bias1.accelerometer();
+    Vector3 delta_BiasGyro = Bias1.gyroscope();
+    if (Bias_initial_){
+      delta_BiasAcc  -= Bias_initial_->accelerometer();
+      delta_BiasGyro -= Bias_initial_->gyroscope();
     }
-
-    // Jacobian w.r.t. Vel1
-    if (H2){
-      if (Vel1.size()!=3) throw std::runtime_error("Frank's hack to make this compile will not work if size != 3");
-      Matrix H2_Pose = numericalDerivative11<POSE, Vector3>(boost::bind(&EquivInertialNavFactor_GlobalVel::evaluatePoseError, this, Pose1, _1, Bias1, Pose2, Vel2), Vel1);
-      Matrix H2_Vel = numericalDerivative11<Vector3, Vector3>(boost::bind(&EquivInertialNavFactor_GlobalVel::evaluateVelocityError, this, Pose1, _1, Bias1, Pose2, Vel2), Vel1);
-      *H2 = stack(2, &H2_Pose, &H2_Vel);
+    const Matrix3 J_angles_wrt_BiasGyro = Jacobian_wrt_t0_Overall_.block<3,3>(0,12);
+    const Matrix3 J_Pos_wrt_BiasAcc  = Jacobian_wrt_t0_Overall_.block<3,3>(4,9);
+    const Matrix3 J_Pos_wrt_BiasGyro = Jacobian_wrt_t0_Overall_.block<3,3>(4,12);
+    const Matrix3 J_Vel_wrt_BiasAcc  = Jacobian_wrt_t0_Overall_.block<3,3>(6,9);
+    const Matrix3 J_Vel_wrt_BiasGyro = Jacobian_wrt_t0_Overall_.block<3,3>(6,12);
+    const Vector3 delta_pos = Vector3(delta_pos_in_t0_) + J_Pos_wrt_BiasAcc*delta_BiasAcc + J_Pos_wrt_BiasGyro*delta_BiasGyro;
+    const Vector3 delta_vel = Vector3(delta_vel_in_t0_) + J_Vel_wrt_BiasAcc*delta_BiasAcc + J_Vel_wrt_BiasGyro*delta_BiasGyro;
+
+    // Predict, as in predictPose_inertial and predictVelocity_inertial
+    const Matrix3 world_R1_body = Pose1.rotation().matrix();
+    const Matrix3 earth_cross = skewSymmetric(Vector3(world_rho_ + world_omega_earth_));
+    const Vector3 body_earth = world_R1_body.transpose() * (world_rho_ + world_omega_earth_);
+    const Matrix3 D_pos_Vel1 = dt12_ * I_3x3 - 2 * dt12_ * dt12_ * earth_cross;
+    Matrix3 D_exp;
+    const typename POSE::Rotation body1_R_body2 = POSE::Rotation::Expmap(
+        delta_angles_ + J_angles_wrt_BiasGyro*delta_BiasGyro - body_earth*dt12_, D_exp);
+    const typename POSE::Rotation world_R2_pred = Pose1.rotation() * body1_R_body2;
+    const Vector3 world_t2_pred = Vector3(Pose1.translation()) + D_pos_Vel1 * Vel1
+        + 0.5*world_g_*dt12_*dt12_ + world_R1_body * delta_pos;
+    const Vector3 Vel2Pred = Vel1 + world_R1_body * delta_vel + world_g_ * dt12_
+        - 2 * dt12_ * earth_cross * Vel1;
+
+    // Errors, with derivatives of DiffPose in its tangent space
+    const POSE DiffPose(Pose2.rotation().between(world_R2_pred),
+        typename POSE::Translation(world_t2_pred - Pose2.translation()));
+    Matrix6 D_log;
+    Vector9 err;
+    err << POSE::Logmap(DiffPose, D_log), Vel2Pred - Vel2;
+
+    const Matrix3 diff_Rt = DiffPose.rotation().transpose();
+    if (H1) {
+      Matrix6 D_diff_Pose1;
+      D_diff_Pose1 << body1_R_body2.transpose() - dt12_ * D_exp * skewSymmetric(body_earth), Z_3x3,
+                      -diff_Rt * world_R1_body * skewSymmetric(delta_pos), diff_Rt * world_R1_body;
+      Matrix96 D;
+      D << D_log * D_diff_Pose1,
+           -world_R1_body * skewSymmetric(delta_vel), Z_3x3;
+      *H1 = D;
     }
-
-    // Jacobian w.r.t. IMUBias1
-    if (H3){
-      Matrix H3_Pose = numericalDerivative11<POSE, IMUBIAS>(boost::bind(&EquivInertialNavFactor_GlobalVel::evaluatePoseError, this, Pose1, Vel1, _1, Pose2, Vel2), Bias1);
-      Matrix H3_Vel = numericalDerivative11<VELOCITY, IMUBIAS>(boost::bind(&EquivInertialNavFactor_GlobalVel::evaluateVelocityError, this, Pose1, Vel1, _1, Pose2, Vel2), Bias1);
-      *H3 = stack(2, &H3_Pose, &H3_Vel);
+    if (H2) {
+      Matrix63 D_diff_Vel1;
+      D_diff_Vel1 << Z_3x3, diff_Rt * D_pos_Vel1;
+      Matrix93 D;
+      D << D_log * D_diff_Vel1, I_3x3 - 2 * dt12_ * earth_cross;
+      *H2 = D;
     }
-
-    // Jacobian w.r.t. Pose2
-    if (H4){
-      Matrix H4_Pose = numericalDerivative11<POSE, POSE>(boost::bind(&EquivInertialNavFactor_GlobalVel::evaluatePoseError, this, Pose1, Vel1, Bias1, _1, Vel2), Pose2);
-      Matrix H4_Vel = numericalDerivative11<VELOCITY, POSE>(boost::bind(&EquivInertialNavFactor_GlobalVel::evaluateVelocityError, this, Pose1, Vel1, Bias1, _1, Vel2), Pose2);
-      *H4 = stack(2, &H4_Pose, &H4_Vel);
+    if (H3) {
+      // The bias tangent space is [accelerometer, gyroscope]
+      Matrix6 D_diff_Bias;
+      D_diff_Bias << Z_3x3, D_exp * J_angles_wrt_BiasGyro,
+                     diff_Rt * world_R1_body * J_Pos_wrt_BiasAcc,
+                     diff_Rt * world_R1_body * J_Pos_wrt_BiasGyro;
+      Matrix96 D;
+      D << D_log * D_diff_Bias,
+           world_R1_body * J_Vel_wrt_BiasAcc, world_R1_body * J_Vel_wrt_BiasGyro;
+      *H3 = D;
     }
-
-    // Jacobian w.r.t. Vel2
-    if (H5){
-      if (Vel2.size()!=3) throw std::runtime_error("Frank's hack to make this compile will not work if size != 3");
-      Matrix H5_Pose = numericalDerivative11<POSE, Vector3>(boost::bind(&EquivInertialNavFactor_GlobalVel::evaluatePoseError, this, Pose1, Vel1, Bias1, Pose2, _1), Vel2);
-      Matrix H5_Vel = numericalDerivative11<Vector3, Vector3>(boost::bind(&EquivInertialNavFactor_GlobalVel::evaluateVelocityError, this, Pose1, Vel1, Bias1, Pose2, _1), Vel2);
-      *H5 = stack(2, &H5_Pose, &H5_Vel);
+    if (H4) {
+      Matrix6 D_diff_Pose2;
+      D_diff_Pose2 << -DiffPose.rotation().transpose(), Z_3x3,
+                      Z_3x3, -diff_Rt * Pose2.rotation().matrix();
+      Matrix96 D;
+      D << D_log * D_diff_Pose2, Matrix36::Zero();
+      *H4 = D;
+    }
+    if (H5) {
+      Matrix93 D;
+      D << Matrix63::Zero(), -I_3x3;
+      *H5 = D;
     }
 
-    Vector ErrPoseVector(POSE::Logmap(evaluatePoseError(Pose1, Vel1, Bias1, Pose2, Vel2)));
-    Vector ErrVelVector(evaluateVelocityError(Pose1, Vel1, Bias1, Pose2, Vel2));
-
-    return concatVectors(2, &ErrPoseVector, &ErrVelVector);
+    return err;
   }
 
 
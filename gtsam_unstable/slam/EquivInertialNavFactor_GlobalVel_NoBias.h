@@ -86,6 +86,10 @@ namespace gtsam {
  *            vehicle
  */
 
+/**
+ * The analytic Jacobians in evaluateError assume POSE = Pose3 and
+ * VELOCITY = Vector3.
+ */
 template<class POSE, class VELOCITY>
 class EquivInertialNavFactor_GlobalVel_NoBias : public NoiseModelFactor4<POSE, VELOCITY, POSE, VELOCITY> {
 
@@ -242,7 +246,7 @@ public:
     VelDelta -= 2*skewSymmetric(world_rho + world_omega_earth)*world_V1_body * dt12;
 
     // Predict
-    return Vel1.compose( VelDelta );
+    return Vel1 + VelDelta;
 
   }
 
@@ -264,7 +268,7 @@ public:
     VELOCITY Vel2Pred = predictVelocity(Pose1, Vel1);
 
     // Calculate error
-    return Vel2.between(Vel2Pred);
+    return Vel2Pred - Vel2;
   }
 
   Vector evaluateError(const POSE& Pose1, const VELOCITY& Vel1, const POSE& Pose2, const VELOCITY& Vel2,
@@ -273,39 +277,56 @@ public:
       boost::optional<Matrix&> H3 = boost::none,
       boost::optional<Matrix&> H4 = boost::none) const {
 
-    // TODO: Write analytical derivative calculations
-    // Jacobian w.r.t. Pose1
-    if (H1){
-      Matrix H1_Pose = numericalDerivative11<POSE, POSE>(boost::bind(&EquivInertialNavFactor_GlobalVel_NoBias::evaluatePoseError, this, _1, Vel1, Pose2, Vel2), Pose1);
-      Matrix H1_Vel = numericalDerivative11<VELOCITY, POSE>(boost::bind(&EquivInertialNavFactor_GlobalVel_NoBias::evaluateVelocityError, this, _1, Vel1, Pose2, Vel2), Pose1);
-      *H1 = stack(2, &H1_Pose, &H1_Vel);
+    // Predict, as in predictPose_inertial
+    const Matrix3 world_R1_body = Pose1.rotation().matrix();
+    const Matrix3 earth_cross = skewSymmetric(Vector3(world_rho_ + world_omega_earth_));
+    const Vector3 body_earth = world_R1_body.transpose() * (world_rho_ + world_omega_earth_);
+    const Vector3 delta_pos(delta_pos_in_t0_);
+    const Matrix3 D_pos_Vel1 = dt12_ * I_3x3 - 2 * dt12_ * dt12_ * earth_cross;
+    Matrix3 D_exp;
+    const typename POSE::Rotation body1_R_body2 =
+        POSE::Rotation::Expmap(delta_angles_ - body_earth*dt12_, D_exp);
+    const POSE Pose2Pred(Pose1.rotation() * body1_R_body2,
+        typename POSE::Translation(Vector3(Pose1.translation()) + D_pos_Vel1 * Vel1
+            + 0.5*world_g_*dt12_*dt12_ + world_R1_body * delta_pos));
+    const Vector3 Vel2Pred = Vel1 + world_R1_body * Vector3(delta_vel_in_t0_)
+        + world_g_ * dt12_ - 2 * dt12_ * earth_cross * Vel1;
+
+    // Pose error, via the between Jacobians, and velocity error Vel2Pred - Vel2
+    Matrix6 D_error_Pose2, D_error_Pose2Pred, D_log;
+    Vector9 err;
+    err << POSE::Logmap(Pose2.between(Pose2Pred, D_error_Pose2, D_error_Pose2Pred), D_log),
+           Vel2Pred - Vel2;
+
+    const Matrix3 pred_R_world = Pose2Pred.rotation().transpose();
+    if (H1) {
+      Matrix6 D_pred_Pose1;
+      D_pred_Pose1 << body1_R_body2.transpose() - dt12_ * D_exp * skewSymmetric(body_earth), Z_3x3,
+                      -pred_R_world * world_R1_body * skewSymmetric(delta_pos), pred_R_world * world_R1_body;
+      Matrix96 D;
+      D << D_log * D_error_Pose2Pred * D_pred_Pose1,
+           -world_R1_body * skewSymmetric(Vector3(delta_vel_in_t0_)), Z_3x3;
+      *H1 = D;
     }
-
-    // Jacobian w.r.t. Vel1
-    if (H2){
-      Matrix H2_Pose = numericalDerivative11<POSE, VELOCITY>(boost::bind(&EquivInertialNavFactor_GlobalVel_NoBias::evaluatePoseError, this, Pose1, _1, Pose2, Vel2), Vel1);
-      Matrix H2_Vel = numericalDerivative11<VELOCITY, VELOCITY>(boost::bind(&EquivInertialNavFactor_GlobalVel_NoBias::evaluateVelocityError, this, Pose1, _1, Pose2, Vel2), Vel1);
-      *H2 = stack(2, &H2_Pose, &H2_Vel);
+    if (H2) {
+      Matrix63 D_pred_Vel1;
+      D_pred_Vel1 << Z_3x3, pred_R_world * D_pos_Vel1;
+      Matrix93 D;
+      D << D_log * D_error_Pose2Pred * D_pred_Vel1, I_3x3 - 2 * dt12_ * earth_cross;
+      *H2 = D;
     }
-
-    // Jacobian w.r.t. Pose2
-    if (H3){
-      Matrix H3_Pose = numericalDerivative11<POSE, POSE>(boost::bind(&EquivInertialNavFactor_GlobalVel_NoBias::evaluatePoseError, this, Pose1, Vel1, _1, Vel2), Pose2);
-      Matrix H3_Vel = numericalDerivative11<VELOCITY, POSE>(boost::bind(&EquivInertialNavFactor_GlobalVel_NoBias::evaluateVelocityError, this, Pose1, Vel1, _1, Vel2), Pose2);
-      *H3 = stack(2, &H3_Pose, &H3_Vel);
+    if (H3) {
+      Matrix96 D;
+      D << D_log * D_error_Pose2, Matrix36::Zero();
+      *H3 = D;
     }
-
-    // Jacobian w.r.t. Vel2
-    if (H4){
-      Matrix H4_Pose = numericalDerivative11<POSE, VELOCITY>(boost::bind(&EquivInertialNavFactor_GlobalVel_NoBias::evaluatePoseError, this, Pose1, Vel1, Pose2, _1), Vel2);
-      Matrix H4_Vel = numericalDerivative11<VELOCITY, VELOCITY>(boost::bind(&EquivInertialNavFactor_GlobalVel_NoBias::evaluateVelocityError, this, Pose1, Vel1, Pose2, _1), Vel2);
-      *H4 = stack(2, &H4_Pose, &H4_Vel);
+    if (H4) {
+      Matrix93 D;
+      D << Matrix63::Zero(), -I_3x3;
+      *H4 = D;
     }
 
-    Vector ErrPoseVector(POSE::Logmap(evaluatePoseError(Pose1, Vel1, Pose2, Vel2)));
-    Vector ErrVelVector(VELOCITY::Logmap(evaluateVelocityError(Pose1, Vel1, Pose2, Vel2)));
-
-    return concatVectors(2, &ErrPoseVector, &ErrVelVector);
+    return err;
   }
 
 
@@ -370,15 +391,15 @@ public:
     Matrix Z_3x3 = Z_3x3;
     Matrix I_3x3 = I_3x3;
 
-    Matrix H_pos_pos = numericalDerivative11<LieVector, LieVector>(boost::bind(&PreIntegrateIMUObservations_delta_pos, msr_dt, _1, delta_vel_in_t0), delta_pos_in_t0);
-    Matrix H_pos_vel = numericalDerivative11<LieVector, LieVector>(boost::bind(&PreIntegrateIMUObservations_delta_pos, msr_dt, delta_pos_in_t0, _1), delta_vel_in_t0);
+    Matrix H_pos_pos = numericalDerivative11<Vector3, Vector3>(boost::bind(&PreIntegrateIMUObservations_delta_pos, msr_dt, _1, delta_vel_in_t0), delta_pos_in_t0);
+    Matrix H_pos_vel = numericalDerivative11<Vector3, Vector3>(boost::bind(&PreIntegrateIMUObservations_delta_pos, msr_dt, delta_pos_in_t0, _1), delta_vel_in_t0);
     Matrix H_pos_angles = Z_3x3;
 
-    Matrix H_vel_vel = numericalDerivative11<LieVector, LieVector>(boost::bind(&PreIntegrateIMUObservations_delta_vel, msr_gyro_t, msr_acc_t, msr_dt, delta_angles, _1, flag_use_body_P_sensor, body_P_sensor), delta_vel_in_t0);
-    Matrix H_vel_angles = numericalDerivative11<LieVector, LieVector>(boost::bind(&PreIntegrateIMUObservations_delta_vel, msr_gyro_t, msr_acc_t, msr_dt, _1, delta_vel_in_t0, flag_use_body_P_sensor, body_P_sensor), delta_angles);
+    Matrix H_vel_vel = numericalDerivative11<Vector3, Vector3>(boost::bind(&PreIntegrateIMUObservations_delta_vel, msr_gyro_t, msr_acc_t, msr_dt, delta_angles, _1, flag_use_body_P_sensor, body_P_sensor), delta_vel_in_t0);
+    Matrix H_vel_angles = numericalDerivative11<Vector3, Vector3>(boost::bind(&PreIntegrateIMUObservations_delta_vel, msr_gyro_t, msr_acc_t, msr_dt, _1, delta_vel_in_t0, flag_use_body_P_sensor, body_P_sensor), delta_angles);
     Matrix H_vel_pos = Z_3x3;
 
-    Matrix H_angles_angles = numericalDerivative11<LieVector, LieVector>(boost::bind(&PreIntegrateIMUObservations_delta_angles, msr_gyro_t, msr_dt, _1, flag_use_body_P_sensor, body_P_sensor), delta_angles);
+    Matrix H_angles_angles = numericalDerivative11<Vector3, Vector3>(boost::bind(&PreIntegrateIMUObservations_delta_angles, msr_gyro_t, msr_dt, _1, flag_use_body_P_sensor, body_P_sensor), delta_angles);
     Matrix H_angles_pos = Z_3x3;
     Matrix H_angles_vel = Z_3x3;
 
@@ -388,7 +409,7 @@ public:
     Matrix F = stack(3, &F_angles, &F_pos, &F_vel);
 
     noiseModel::Gaussian::shared_ptr model_discrete_curr = calc_descrete_noise_model(model_continuous_overall, msr_dt );
-    Matrix Q_d = inverse(model_discrete_curr->R().transpose() * model_discrete_curr->R() );
+    Matrix Q_d = (model_discrete_curr->R().transpose() * model_discrete_curr->R()).inverse();
 
     EquivCov_Overall = F * EquivCov_Overall * F.transpose() + Q_d;
 
@@ -458,9 +479,9 @@ public:
   static inline noiseModel::Gaussian::shared_ptr CalcEquivalentNoiseCov(const noiseModel::Gaussian::shared_ptr& gaussian_acc, const noiseModel::Gaussian::shared_ptr& gaussian_gyro,
       const noiseModel::Gaussian::shared_ptr& gaussian_process){
 
-    Matrix cov_acc = inverse( gaussian_acc->R().transpose() * gaussian_acc->R() );
-    Matrix cov_gyro = inverse( gaussian_gyro->R().transpose() * gaussian_gyro->R() );
-    Matrix cov_process = inverse( gaussian_process->R().transpose() * gaussian_process->R() );
+    Matrix cov_acc = ( gaussian_acc->R().transpose() * gaussian_acc->R() ).inverse();
+    Matrix cov_gyro = ( gaussian_gyro->R().transpose() * gaussian_gyro->R() ).inverse();
+    Matrix cov_process = ( gaussian_process->R().transpose() * gaussian_process->R() ).inverse();
 
     cov_process.block(0,0, 3,3) += cov_gyro;
     cov_process.block(6,6, 3,3) += cov_acc;
@@ -472,9 +493,9 @@ public:
       const noiseModel::Gaussian::shared_ptr& gaussian_process,
       Matrix& cov_acc, Matrix& cov_gyro, Matrix& cov_process_without_acc_gyro){
 
-    cov_acc = inverse( gaussian_acc->R().transpose() * gaussian_acc->R() );
-    cov_gyro = inverse( gaussian_gyro->R().transpose() * gaussian_gyro->R() );
-    cov_process_without_acc_gyro = inverse( gaussian_process->R().transpose() * gaussian_process->R() );
+    cov_acc = ( gaussian_acc->R().transpose() * gaussian_acc->R() ).inverse();
+    cov_gyro = ( gaussian_gyro->R().transpose() * gaussian_gyro->R() ).inverse();
+    cov_process_without_acc_gyro = ( gaussian_process->R().transpose() * gaussian_process->R() ).inverse();
   }
 
   static inline void Calc_g_rho_omega_earth_NED(const Vector& Pos_NED, const Vector& Vel_NED, const Vector& LatLonHeight_IC, const Vector& Pos_NED_Initial,
@@ -536,7 +557,7 @@ public:
 
     Rot3 R_ECEF_to_ENU( UEN_to_ENU * C2 * C1 );
 
-    Vector omega_earth_ECEF((Vector(3) << 0.0, 0.0, 7.292115e-5));
+    Vector omega_earth_ECEF(Vector3(0.0, 0.0, 7.292115e-5));
     omega_earth_ENU = R_ECEF_to_ENU.matrix() * omega_earth_ECEF;
 
     // Calculating g
@@ -550,7 +571,7 @@ public:
     double Ro( sqrt(Rp*Rm) );           // mean earth radius of curvature
     double g0( 9.780318*( 1 + 5.3024e-3 * pow(sin(lat_new),2) - 5.9e-6 * pow(sin(2*lat_new),2) ) );
     double g_calc( g0/( pow(1 + height/Ro, 2) ) );
-    g_ENU = (Vector(3) << 0.0, 0.0, -g_calc);
+    g_ENU = (Vector(3) << 0.0, 0.0, -g_calc).finished();
 
 
     // Calculate rho
@@ -559,7 +580,7 @@ public:
     double rho_E = -Vn/(Rm + height);
     double rho_N = Ve/(Rp + height);
     double rho_U = Ve*tan(lat_new)/(Rp + height);
-    rho_ENU = (Vector(3) << rho_E, rho_N, rho_U);
+    rho_ENU = (Vector(3) << rho_E, rho_N, rho_U).finished();
   }
 
   static inline noiseModel::Gaussian::shared_ptr calc_descrete_noise_model(const noiseModel::Gaussian::shared_ptr& model, double delta_t){
@@ -93,6 +93,46 @@ private:
 
   boost::optional<POSE> body_P_sensor_; // The pose of the sensor in the body frame
 
+  // The predicted pose and velocity, with the intermediate terms evaluateError needs for its derivatives
+  struct Prediction {
+    Matrix3 world_R1_body;     // Rotation of Pose1
+    Vector3 earth;             // Craft rate plus earth's rotation, in the world frame
+    Vector3 body_earth;        // The same in the body frame
+    Matrix3 body_R_sensor;     // Rotation of the sensor in the body frame, identity if none
+    Vector3 body_omega_sensor; // Bias-corrected angular velocity, in the body frame
+    Vector3 body_a_body;       // Bias-corrected acceleration of the body, with the lever arm term
+    Matrix3 D_a_omega;         // Derivative of body_a_body w.r.t. body_omega_sensor
+    Matrix3 D_exp;             // Derivative of Expmap at the rotation increment
+    typename POSE::Rotation body1_R_body2;
+    POSE Pose2;
+    VELOCITY Vel2;
+  };
+
+  Prediction prediction(const POSE& Pose1, const VELOCITY& Vel1, const IMUBIAS& Bias1) const {
+    Prediction p;
+    p.world_R1_body = Pose1.rotation().matrix();
+    p.earth = world_rho_ + world_omega_earth_;
+    p.body_earth = p.world_R1_body.transpose() * p.earth;
+
+    // Calculate the acceleration and angular velocity of the body in the body frame
+    p.body_R_sensor = body_P_sensor_ ? body_P_sensor_->rotation().matrix() : I_3x3;
+    p.body_omega_sensor = p.body_R_sensor * Bias1.correctGyroscope(measurement_gyro_);
+    p.body_a_body = p.body_R_sensor * Bias1.correctAccelerometer(measurement_acc_);
+    p.D_a_omega = Z_3x3;
+    if (body_P_sensor_) {
+      const Vector3 body_t_sensor = body_P_sensor_->translation();
+      const Matrix3 omega_cross = skewSymmetric(p.body_omega_sensor);
+      p.body_a_body -= omega_cross * omega_cross * body_t_sensor;
+      p.D_a_omega = skewSymmetric(omega_cross * body_t_sensor) + omega_cross * skewSymmetric(body_t_sensor);
+    }
+
+    // Correct for earth-related terms, the velocity is in the global frame, so composing Pose1 with v*dt is incorrect
+    p.body1_R_body2 = POSE::Rotation::Expmap((p.body_omega_sensor - p.body_earth) * dt_, p.D_exp);
+    p.Pose2 = POSE(Pose1.rotation() * p.body1_R_body2, Pose1.translation() + typename POSE::Translation(Vel1 * dt_));
+    p.Vel2 = Vel1 + VELOCITY((p.world_R1_body * p.body_a_body + world_g_ - 2 * skewSymmetric(p.earth) * Vel1) * dt_);
+    return p;
+  }
+
 public:
 
   // shorthand for a smart pointer to a factor
@@ -146,65 +186,17 @@ public:
   }
 
   POSE predictPose(const POSE& Pose1, const VELOCITY& Vel1, const IMUBIAS& Bias1) const {
-    // Calculate the corrected measurements using the Bias object
-    Vector GyroCorrected(Bias1.correctGyroscope(measurement_gyro_));
-
-    const POSE& world_P1_body = Pose1;
-    const VELOCITY& world_V1_body = Vel1;
-
-    // Calculate the acceleration and angular velocity of the body in the body frame (including earth-related rotations)
-    Vector body_omega_body;
-    if(body_P_sensor_) {
-      body_omega_body = body_P_sensor_->rotation().matrix() * GyroCorrected;
-    } else {
-      body_omega_body = GyroCorrected;
-    }
-
-    // Convert earth-related terms into the body frame
-    Matrix body_R_world(world_P1_body.rotation().inverse().matrix());
-    Vector body_rho = body_R_world * world_rho_;
-    Vector body_omega_earth = body_R_world * world_omega_earth_;
-
-    // Correct for earth-related terms
-    body_omega_body -= body_rho + body_omega_earth;
-
-    // The velocity is in the global frame, so composing Pose1 with v*dt is incorrect
-    return POSE(Pose1.rotation() * POSE::Rotation::Expmap(body_omega_body*dt_), Pose1.translation() + typename POSE::Translation(world_V1_body*dt_));
+    return prediction(Pose1, Vel1, Bias1).Pose2;
   }
 
   VELOCITY predictVelocity(const POSE& Pose1, const VELOCITY& Vel1, const IMUBIAS& Bias1) const {
-    // Calculate the corrected measurements using the Bias object
-    Vector AccCorrected(Bias1.correctAccelerometer(measurement_acc_));
-
-    const POSE& world_P1_body = Pose1;
-    const VELOCITY& world_V1_body = Vel1;
-
-    // Calculate the acceleration and angular velocity of the body in the body frame (including earth-related rotations)
-    Vector body_a_body, body_omega_body;
-    if(body_P_sensor_) {
-      Matrix body_R_sensor = body_P_sensor_->rotation().matrix();
-
-      Vector GyroCorrected(Bias1.correctGyroscope(measurement_gyro_));
-      body_omega_body = body_R_sensor * GyroCorrected;
-      Matrix body_omega_body__cross = skewSymmetric(body_omega_body);
-      body_a_body = body_R_sensor * AccCorrected - body_omega_body__cross * body_omega_body__cross * body_P_sensor_->translation();
-    } else {
-      body_a_body = AccCorrected;
-    }
-
-    // Correct for earth-related terms
-    Vector world_a_body = world_P1_body.rotation().matrix() * body_a_body + world_g_ - 2*skewSymmetric(world_rho_ + world_omega_earth_)*world_V1_body;
-
-    // Calculate delta in the body frame
-    VELOCITY VelDelta(world_a_body*dt_);
-
-    // Predict
-    return Vel1 + VelDelta;
+    return prediction(Pose1, Vel1, Bias1).Vel2;
   }
 
   void predict(const POSE& Pose1, const VELOCITY& Vel1, const IMUBIAS& Bias1, POSE& Pose2, VELOCITY& Vel2) const {
-    Pose2 = predictPose(Pose1, Vel1, Bias1);
-    Vel2 = predictVelocity(Pose1, Vel1, Bias1);
+    const Prediction p = prediction(Pose1, Vel1, Bias1);
+    Pose2 = p.Pose2;
+    Vel2 = p.Vel2;
   }
 
   POSE evaluatePoseError(const POSE& Pose1, const VELOCITY& Vel1, const IMUBIAS& Bias1, const POSE& Pose2, const VELOCITY& Vel2) const {
@@ -231,48 +223,61 @@ public:
       boost::optional<Matrix&> H4 = boost::none,
       boost::optional<Matrix&> H5 = boost::none) const {
 
-    // TODO: Write analytical derivative calculations
-    // Jacobian w.r.t. Pose1
-    if (H1){
-      Matrix H1_Pose = gtsam::numericalDerivative11<POSE, POSE>(boost::bind(&InertialNavFactor_GlobalVelocity::evaluatePoseError, this, _1, Vel1, Bias1, Pose2, Vel2), Pose1);
-      Matrix H1_Vel = gtsam::numericalDerivative11<VELOCITY, POSE>(boost::bind(&InertialNavFactor_GlobalVelocity::evaluateVelocityError, this, _1, Vel1, Bias1, Pose2, Vel2), Pose1);
-      *H1 = stack(2, &H1_Pose, &H1_Vel);
+    // Predict, with the terms of the derivatives of the predicted pose in its tangent space
+    const Prediction p = prediction(Pose1, Vel1, Bias1);
+    const Matrix3& world_R1_body = p.world_R1_body;
+    const Matrix3& body_R_sensor = p.body_R_sensor;
+    const Matrix3& D_exp = p.D_exp;
+
+    // Errors
+    Matrix6 D_error_Pose2, D_error_Pose2Pred, D_log;
+    const Vector6 ErrPose = POSE::Logmap(Pose2.between(p.Pose2,
+        H4 ? &D_error_Pose2 : 0, D_error_Pose2Pred), D_log);
+    Vector9 err;
+    err << ErrPose, p.Vel2 - Vel2;
+
+    const Matrix6 D_err_Pose2Pred = D_log * D_error_Pose2Pred;
+    const Matrix3 body2_R_body1 = p.body1_R_body2.transpose();
+    if (H1) {
+      Matrix6 D_Pose2Pred_Pose1;
+      D_Pose2Pred_Pose1 << body2_R_body1 - dt_ * D_exp * skewSymmetric(p.body_earth), Z_3x3,
+                           Z_3x3, body2_R_body1;
+      Matrix96 D;
+      D << D_err_Pose2Pred * D_Pose2Pred_Pose1,
+           -dt_ * world_R1_body * skewSymmetric(p.body_a_body), Z_3x3;
+      *H1 = D;
     }
-
-    // Jacobian w.r.t. Vel1
-    if (H2){
-      if (Vel1.size()!=3) throw std::runtime_error("Frank's hack to make this compile will not work if size != 3");
-      Matrix H2_Pose = gtsam::numericalDerivative11<POSE, Vector3>(boost::bind(&InertialNavFactor_GlobalVelocity::evaluatePoseError, this, Pose1, _1, Bias1, Pose2, Vel2), Vel1);
-      Matrix H2_Vel = gtsam::numericalDerivative11<Vector3, Vector3>(boost::bind(&InertialNavFactor_GlobalVelocity::evaluateVelocityError, this, Pose1, _1, Bias1, Pose2, Vel2), Vel1);
-      *H2 = stack(2, &H2_Pose, &H2_Vel);
+    if (H2) {
+      Matrix63 D_Pose2Pred_Vel1;
+      D_Pose2Pred_Vel1 << Z_3x3, dt_ * body2_R_body1 * world_R1_body.transpose();
+      Matrix93 D;
+      D << D_err_Pose2Pred * D_Pose2Pred_Vel1,
+           I_3x3 - 2 * dt_ * skewSymmetric(p.earth);
+      *H2 = D;
     }
-
-    // Jacobian w.r.t. IMUBias1
-    if (H3){
-      Matrix H3_Pose = gtsam::numericalDerivative11<POSE, IMUBIAS>(boost::bind(&InertialNavFactor_GlobalVelocity::evaluatePoseError, this, Pose1, Vel1, _1, Pose2, Vel2), Bias1);
-      Matrix H3_Vel = gtsam::numericalDerivative11<VELOCITY, IMUBIAS>(boost::bind(&InertialNavFactor_GlobalVelocity::evaluateVelocityError, this, Pose1, Vel1, _1, Pose2, Vel2), Bias1);
-      *H3 = stack(2, &H3_Pose, &H3_Vel);
+    if (H3) {
+      // The bias tangent space is [accelerometer, gyroscope]
+      Matrix6 D_Pose2Pred_Bias;
+      D_Pose2Pred_Bias << Z_3x3, -dt_ * D_exp * body_R_sensor,
+                          Z_3x3, Z_3x3;
+      Matrix96 D;
+      D << D_err_Pose2Pred * D_Pose2Pred_Bias,
+           -dt_ * world_R1_body * body_R_sensor,
+           -dt_ * world_R1_body * p.D_a_omega * body_R_sensor;
+      *H3 = D;
     }
-
-    // Jacobian w.r.t. Pose2
-    if (H4){
-      Matrix H4_Pose = gtsam::numericalDerivative11<POSE, POSE>(boost::bind(&InertialNavFactor_GlobalVelocity::evaluatePoseError, this, Pose1, Vel1, Bias1, _1, Vel2), Pose2);
-      Matrix H4_Vel = gtsam::numericalDerivative11<VELOCITY, POSE>(boost::bind(&InertialNavFactor_GlobalVelocity::evaluateVelocityError, this, Pose1, Vel1, Bias1, _1, Vel2), Pose2);
-      *H4 = stack(2, &H4_Pose, &H4_Vel);
+    if (H4) {
+      Matrix96 D;
+      D << D_log * D_error_Pose2, Matrix36::Zero();
+      *H4 = D;
     }
-
-    // Jacobian w.r.t. Vel2
-    if (H5){
-      if (Vel2.size()!=3) throw std::runtime_error("Frank's hack to make this compile will not work if size != 3");
-      Matrix H5_Pose = gtsam::numericalDerivative11<POSE, Vector3>(boost::bind(&InertialNavFactor_GlobalVelocity::evaluatePoseError, this, Pose1, Vel1, Bias1, Pose2, _1), Vel2);
-      Matrix H5_Vel = gtsam::numericalDerivative11<Vector3, Vector3>(boost::bind(&InertialNavFactor_GlobalVelocity::evaluateVelocityError, this, Pose1, Vel1, Bias1, Pose2, _1), Vel2);
-      *H5 = stack(2, &H5_Pose, &H5_Vel);
+    if (H5) {
+      Matrix93 D;
+      D << Matrix63::Zero(), -I_3x3;
+      *H5 = D;
     }
 
-    Vector ErrPoseVector(POSE::Logmap(evaluatePoseError(Pose1, Vel1, Bias1, Pose2, Vel2)));
-    Vector ErrVelVector(evaluateVelocityError(Pose1, Vel1, Bias1, Pose2, Vel2));
-
-    return concatVectors(2, &ErrPoseVector, &ErrVelVector);
+    return err;
   }
 
   static inline noiseModel::Gaussian::shared_ptr CalcEquivalentNoiseCov(const noiseModel::Gaussian::shared_ptr& gaussian_acc, const noiseModel::Gaussian::shared_ptr& gaussian_gyro,
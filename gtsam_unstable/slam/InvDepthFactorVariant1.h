@@ -11,11 +11,10 @@
 #pragma once
 
 #include <gtsam/nonlinear/NonlinearFactor.h>
-#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/PinholePose.h>
 #include <gtsam/geometry/Cal3_S2.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Point2.h>
-#include <gtsam/base/numericalDerivative.h>
 
 namespace gtsam {
 
@@ -80,16 +79,34 @@ public:
         && this->K_->equals(*e->K_, tol);
   }
 
-  Vector inverseDepthError(const Pose3& pose, const Vector6& landmark) const {
+  Vector inverseDepthError(const Pose3& pose, const Vector6& landmark,
+      OptionalJacobian<2,6> H1 = boost::none,
+      OptionalJacobian<2,6> H2 = boost::none) const {
     try {
       // Calculate the 3D coordinates of the landmark in the world frame
       double x = landmark(0), y = landmark(1), z = landmark(2);
       double theta = landmark(3), phi = landmark(4), rho = landmark(5);
-      Point3 world_P_landmark = Point3(x, y, z) + Point3(cos(theta)*cos(phi)/rho, sin(theta)*cos(phi)/rho, sin(phi)/rho);
+      const double cos_theta = cos(theta), sin_theta = sin(theta);
+      const double cos_phi = cos(phi), sin_phi = sin(phi);
+      const Point3 m(cos_theta*cos_phi, sin_theta*cos_phi, sin_phi);
+      Point3 world_P_landmark = Point3(x, y, z) + m/rho;
       // Project landmark into Pose2
-      PinholeCamera<Cal3_S2> camera(pose, *K_);
-      return camera.project(world_P_landmark) - measured_;
+      PinholePose<Cal3_S2> camera(pose, K_);
+      Matrix23 D_project_landmark;
+      const Point2 uv = camera.project(world_P_landmark, H1,
+          H2 ? &D_project_landmark : 0);
+      if (H2) {
+        Matrix36 D_landmark;
+        D_landmark << I_3x3,
+            Vector3(-sin_theta*cos_phi, cos_theta*cos_phi, 0)/rho,
+            Vector3(-cos_theta*sin_phi, -sin_theta*sin_phi, cos_phi)/rho,
+            -m/(rho*rho);
+        *H2 = D_project_landmark * D_landmark;
+      }
+      return uv - measured_;
     } catch( CheiralityException& e) {
+      if (H1) H1->setZero();
+      if (H2) H2->setZero();
       std::cout << e.what()
           << ": Inverse Depth Landmark [" << DefaultKeyFormatter(this->key2()) << "]"
           << " moved behind camera [" << DefaultKeyFormatter(this->key1()) <<"]"
@@ -103,19 +120,7 @@ public:
   Vector evaluateError(const Pose3& pose, const Vector6& landmark,
       boost::optional<Matrix&> H1=boost::none,
       boost::optional<Matrix&> H2=boost::none) const {
-
-    if (H1) {
-      (*H1) = numericalDerivative11<Vector, Pose3>(
-          boost::bind(&InvDepthFactorVariant1::inverseDepthError, this, _1,
-              landmark), pose);
-    }
-    if (H2) {
-      (*H2) = numericalDerivative11<Vector, Vector6>(
-          boost::bind(&InvDepthFactorVariant1::inverseDepthError, this, pose,
-              _1), landmark);
-    }
-
-    return inverseDepthError(pose, landmark);
+    return inverseDepthError(pose, landmark, H1, H2);
   }
 
   /** return the measurement */
@@ -12,11 +12,10 @@
 #pragma once
 
 #include <gtsam/nonlinear/NonlinearFactor.h>
-#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/PinholePose.h>
 #include <gtsam/geometry/Cal3_S2.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Point2.h>
-#include <gtsam/base/numericalDerivative.h>
 
 namespace gtsam {
 
@@ -84,15 +83,32 @@ public:
         && traits<Point3>::Equals(this->referencePoint_, e->referencePoint_, tol);
   }
 
-  Vector inverseDepthError(const Pose3& pose, const Vector3& landmark) const {
+  Vector inverseDepthError(const Pose3& pose, const Vector3& landmark,
+      OptionalJacobian<2,6> H1 = boost::none,
+      OptionalJacobian<2,3> H2 = boost::none) const {
     try {
       // Calculate the 3D coordinates of the landmark in the world frame
       double theta = landmark(0), phi = landmark(1), rho = landmark(2);
-      Point3 world_P_landmark = referencePoint_ + Point3(cos(theta)*cos(phi)/rho, sin(theta)*cos(phi)/rho, sin(phi)/rho);
+      const double cos_theta = cos(theta), sin_theta = sin(theta);
+      const double cos_phi = cos(phi), sin_phi = sin(phi);
+      const Point3 m(cos_theta*cos_phi, sin_theta*cos_phi, sin_phi);
+      Point3 world_P_landmark = referencePoint_ + m/rho;
       // Project landmark into Pose2
-      PinholeCamera<Cal3_S2> camera(pose, *K_);
-      return camera.project(world_P_landmark) - measured_;
+      PinholePose<Cal3_S2> camera(pose, K_);
+      Matrix23 D_project_landmark;
+      const Point2 uv = camera.project(world_P_landmark, H1,
+          H2 ? &D_project_landmark : 0);
+      if (H2) {
+        Matrix3 D_landmark;
+        D_landmark << Vector3(-sin_theta*cos_phi, cos_theta*cos_phi, 0)/rho,
+            Vector3(-cos_theta*sin_phi, -sin_theta*sin_phi, cos_phi)/rho,
+            -m/(rho*rho);
+        *H2 = D_project_landmark * D_landmark;
+      }
+      return uv - measured_;
     } catch( CheiralityException& e) {
+      if (H1) H1->setZero();
+      if (H2) H2->setZero();
       std::cout << e.what()
           << ": Inverse Depth Landmark [" << DefaultKeyFormatter(this->key2()) << "]"
           << " moved behind camera [" << DefaultKeyFormatter(this->key1()) <<"]"
@@ -106,19 +122,7 @@ public:
   Vector evaluateError(const Pose3& pose, const Vector3& landmark,
       boost::optional<Matrix&> H1=boost::none,
       boost::optional<Matrix&> H2=boost::none) const {
-
-    if (H1) {
-      (*H1) = numericalDerivative11<Vector, Pose3>(
-          boost::bind(&InvDepthFactorVariant2::inverseDepthError, this, _1,
-              landmark), pose);
-    }
-    if (H2) {
-      (*H2) = numericalDerivative11<Vector, Vector3>(
-          boost::bind(&InvDepthFactorVariant2::inverseDepthError, this, pose,
-              _1), landmark);
-    }
-
-    return inverseDepthError(pose, landmark);
+    return inverseDepthError(pose, landmark, H1, H2);
   }
 
   /** return the measurement */
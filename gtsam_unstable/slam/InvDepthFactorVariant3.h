@@ -11,14 +11,31 @@
 #pragma once
 
 #include <gtsam/nonlinear/NonlinearFactor.h>
-#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/PinholePose.h>
 #include <gtsam/geometry/Cal3_S2.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Point2.h>
-#include <gtsam/base/numericalDerivative.h>
 
 namespace gtsam {
 
+/**
+ * Point in the reference pose frame of a (theta,phi,rho) landmark, with the
+ * z axis pointing forward, and optionally its derivative w.r.t. the landmark
+ */
+inline Point3 invDepthToPoint3(const Vector3& landmark,
+    OptionalJacobian<3,3> H = boost::none) {
+  double theta = landmark(0), phi = landmark(1), rho = landmark(2);
+  const double cos_theta = cos(theta), sin_theta = sin(theta);
+  const double cos_phi = cos(phi), sin_phi = sin(phi);
+  const Point3 m(cos_phi*sin_theta, sin_phi, cos_phi*cos_theta);
+  if (H) {
+    *H << Vector3(cos_phi*cos_theta, 0, -cos_phi*sin_theta)/rho,
+        Vector3(-sin_phi*sin_theta, cos_phi, -sin_phi*cos_theta)/rho,
+        -m/(rho*rho);
+  }
+  return m/rho;
+}
+
 /**
  * Binary factor representing the first visual measurement using an inverse-depth parameterization
  */
@@ -82,17 +99,29 @@ public:
         && this->K_->equals(*e->K_, tol);
   }
 
-  Vector inverseDepthError(const Pose3& pose, const Vector3& landmark) const {
+  Vector inverseDepthError(const Pose3& pose, const Vector3& landmark,
+      OptionalJacobian<2,6> H1 = boost::none,
+      OptionalJacobian<2,3> H2 = boost::none) const {
     try {
       // Calculate the 3D coordinates of the landmark in the Pose frame
-      double theta = landmark(0), phi = landmark(1), rho = landmark(2);
-      Point3 pose_P_landmark(cos(phi)*sin(theta)/rho, sin(phi)/rho, cos(phi)*cos(theta)/rho);
+      Matrix3 D_landmark;
+      Point3 pose_P_landmark = invDepthToPoint3(landmark, H2 ? &D_landmark : 0);
       // Convert the landmark to world coordinates
-      Point3 world_P_landmark = pose.transformFrom(pose_P_landmark);
+      Matrix36 D_world_pose;
+      Matrix3 D_world_landmark;
+      Point3 world_P_landmark = pose.transformFrom(pose_P_landmark,
+          H1 ? &D_world_pose : 0, H2 ? &D_world_landmark : 0);
       // Project landmark into Pose2
-      PinholeCamera<Cal3_S2> camera(pose, *K_);
-      return camera.project(world_P_landmark) - measured_;
+      PinholePose<Cal3_S2> camera(pose, K_);
+      Matrix23 D_project_world;
+      const Point2 uv = camera.project(world_P_landmark, H1,
+          H1 || H2 ? &D_project_world : 0);
+      if (H1) *H1 += D_project_world * D_world_pose;
+      if (H2) *H2 = D_project_world * D_world_landmark * D_landmark;
+      return uv - measured_;
     } catch( CheiralityException& e) {
+      if (H1) H1->setZero();
+      if (H2) H2->setZero();
       std::cout << e.what()
           << ": Inverse Depth Landmark [" << DefaultKeyFormatter(this->key1()) << "," << DefaultKeyFormatter(this->key2()) << "]"
           << " moved behind camera [" << DefaultKeyFormatter(this->key1()) << "]"
@@ -106,15 +135,7 @@ public:
   Vector evaluateError(const Pose3& pose, const Vector3& landmark,
       boost::optional<Matrix&> H1=boost::none,
       boost::optional<Matrix&> H2=boost::none) const {
-
-    if(H1) {
-      (*H1) = numericalDerivative11<Vector,Pose3>(boost::bind(&InvDepthFactorVariant3a::inverseDepthError, this, _1, landmark), pose);
-    }
-    if(H2) {
-      (*H2) = numericalDerivative11<Vector,Vector3>(boost::bind(&InvDepthFactorVariant3a::inverseDepthError, this, pose, _1), landmark);
-    }
-
-    return inverseDepthError(pose, landmark);
+    return inverseDepthError(pose, landmark, H1, H2);
   }
 
   /** return the measurement */
@@ -202,17 +223,31 @@ public:
         && this->K_->equals(*e->K_, tol);
   }
 
-  Vector inverseDepthError(const Pose3& pose1, const Pose3& pose2, const Vector3& landmark) const {
+  Vector inverseDepthError(const Pose3& pose1, const Pose3& pose2, const Vector3& landmark,
+      OptionalJacobian<2,6> H1 = boost::none,
+      OptionalJacobian<2,6> H2 = boost::none,
+      OptionalJacobian<2,3> H3 = boost::none) const {
     try {
       // Calculate the 3D coordinates of the landmark in the Pose1 frame
-      double theta = landmark(0), phi = landmark(1), rho = landmark(2);
-      Point3 pose1_P_landmark(cos(phi)*sin(theta)/rho, sin(phi)/rho, cos(phi)*cos(theta)/rho);
+      Matrix3 D_landmark;
+      Point3 pose1_P_landmark = invDepthToPoint3(landmark, H3 ? &D_landmark : 0);
       // Convert the landmark to world coordinates
-      Point3 world_P_landmark = pose1.transformFrom(pose1_P_landmark);
+      Matrix36 D_world_pose1;
+      Matrix3 D_world_landmark;
+      Point3 world_P_landmark = pose1.transformFrom(pose1_P_landmark,
+          H1 ? &D_world_pose1 : 0, H3 ? &D_world_landmark : 0);
       // Project landmark into Pose2
-      PinholeCamera<Cal3_S2> camera(pose2, *K_);
-      return camera.project(world_P_landmark) - measured_;
+      PinholePose<Cal3_S2> camera(pose2, K_);
+      Matrix23 D_project_world;
+      const Point2 uv = camera.project(world_P_landmark, H2,
+          H1 || H3 ? &D_project_world : 0);
+      if (H1) *H1 = D_project_world * D_world_pose1;
+      if (H3) *H3 = D_project_world * D_world_landmark * D_landmark;
+      return uv - measured_;
     } catch( CheiralityException& e) {
+      if (H1) H1->setZero();
+      if (H2) H2->setZero();
+      if (H3) H3->setZero();
       std::cout << e.what()
           << ": Inverse Depth Landmark [" << DefaultKeyFormatter(this->key1()) << "," << DefaultKeyFormatter(this->key3()) << "]"
           << " moved behind camera " << DefaultKeyFormatter(this->key2())
@@ -227,17 +262,7 @@ public:
       boost::optional<Matrix&> H1=boost::none,
       boost::optional<Matrix&> H2=boost::none,
       boost::optional<Matrix&> H3=boost::none) const {
-
-    if(H1)
-      (*H1) = numericalDerivative11<Vector,Pose3>(boost::bind(&InvDepthFactorVariant3b::inverseDepthError, this, _1, pose2, landmark), pose1);
-
-    if(H2)
-      (*H2) = numericalDerivative11<Vector,Pose3>(boost::bind(&InvDepthFactorVariant3b::inverseDepthError, this, pose1, _1, landmark), pose2);
-
-    if(H3)
-      (*H3) = numericalDerivative11<Vector,Vector3>(boost::bind(&InvDepthFactorVariant3b::inverseDepthError, this, pose1, pose2, _1), landmark);
-
-    return inverseDepthError(pose1, pose2, landmark);
+    return inverseDepthError(pose1, pose2, landmark, H1, H2, H3);
   }
 
   /** return the measurement */
@@ -0,0 +1,197 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MixtureFactor.cpp
+ * @brief   Base class for EM and max-mixture robust factors
+ */
+
+#include <gtsam_unstable/slam/MixtureFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+MixtureFactor::MixtureFactor(const KeyVector& keys,
+                             const vector<SharedGaussian>& models,
+                             const Vector& priors, Mode mode, double minWeight)
+    : Base(keys),
+      models_(models),
+      priors_(priors),
+      mode_(mode),
+      minWeight_(minWeight) {
+  if (models.empty() || static_cast<size_t>(priors.size()) != models.size())
+    throw invalid_argument(
+        "MixtureFactor: need one prior for each of at least one model");
+  dim_ = models.front()->dim();
+
+  // Stack the square root informations, so that all whitened errors are
+  // computed with a single product, and precompute the normalization
+  // constants log(p_k sqrt|R_k'R_k|) = log(p_k) + sum(log|diag(R_k)|)
+  const size_t K = models.size();
+  stackedR_.resize(K * dim_, dim_);
+  logNormalizers_.resize(K);
+  for (size_t k = 0; k < K; k++) {
+    if (models[k]->dim() != dim_)
+      throw invalid_argument("MixtureFactor: models differ in dimension");
+    const Matrix R = models[k]->R();
+    stackedR_.middleRows(k * dim_, dim_) = R;
+    logNormalizers_(k) =
+        log(priors(k)) + R.diagonal().array().abs().log().sum();
+  }
+}
+
+/* ************************************************************************* */
+void MixtureFactor::print(const string& s,
+                          const KeyFormatter& keyFormatter) const {
+  cout << s << "MixtureFactor(" << (mode_ == EM ? "EM" : "MAX_MIXTURE");
+  for (Key key : keys()) cout << ", " << keyFormatter(key);
+  cout << ")\n";
+  for (size_t k = 0; k < models_.size(); k++) {
+    cout << "  component " << k << ", prior " << priors_(k) << "\n";
+    models_[k]->print("  noise model: ");
+  }
+}
+
+/* ************************************************************************* */
+bool MixtureFactor::equals(const NonlinearFactor& f, double tol) const {
+  const MixtureFactor* e = dynamic_cast<const MixtureFactor*>(&f);
+  if (!e || !Base::equals(f) || mode_ != e->mode_ ||
+      models_.size() != e->models_.size() ||
+      fabs(minWeight_ - e->minWeight_) > tol ||
+      !equal_with_abs_tol(priors_, e->priors_, tol))
+    return false;
+  for (size_t k = 0; k < models_.size(); k++)
+    if (!models_[k]->equals(*e->models_[k], tol)) return false;
+  return true;
+}
+
+/* ************************************************************************* */
+Vector MixtureFactor::weights(const Vector& error) const {
+  // Squared Mahalanobis distances of all components: column k of the
+  // reshaped product is R_k * error
+  const Vector whitened = stackedR_ * error;
+  const Eigen::Map<const Matrix> W(whitened.data(), dim_, models_.size());
+  const Eigen::ArrayXd logP =
+      logNormalizers_.array() - 0.5 * W.colwise().squaredNorm().transpose().array();
+
+  // Normalize in log space, the densities can underflow for large errors
+  Eigen::ArrayXd p = (logP - logP.maxCoeff()).exp();
+  p /= p.sum();
+  if (minWeight_ > 0.0 && p.minCoeff() < minWeight_) {
+    p = p.max(minWeight_);
+    p /= p.sum();
+  }
+  return p.matrix();
+}
+
+/* ************************************************************************* */
+MixtureFactor::Evaluation MixtureFactor::evaluate(const Values& x,
+                                                  bool jacobians) const {
+  Evaluation evaluation;
+  if (jacobians) {
+    evaluation.H.resize(size());
+    evaluation.error = unwhitenedError(x, evaluation.H);
+  } else {
+    evaluation.error = unwhitenedError(x);
+  }
+  evaluation.weights = weights(evaluation.error);
+  return evaluation;
+}
+
+/* ************************************************************************* */
+size_t MixtureFactor::maxComponent(const Values& x) const {
+  // The weights are normalized, so the largest one has the largest
+  // unnormalized log-likelihood, also if weights are clamped
+  Vector::Index k;
+  evaluate(x, false).weights.maxCoeff(&k);
+  return k;
+}
+
+/* ************************************************************************* */
+Vector MixtureFactor::whitenedError(const Values& x) const {
+  const Evaluation evaluation = evaluate(x, false);
+  if (mode_ == MAX_MIXTURE) {
+    Vector::Index k;
+    evaluation.weights.maxCoeff(&k);
+    Vector whitened(dim_ + 1);
+    whitened.head(dim_) =
+        stackedR_.middleRows(k * dim_, dim_) * evaluation.error;
+    whitened(dim_) = sqrt(2.0 * offset(k));
+    return whitened;
+  }
+  Vector whitened = stackedR_ * evaluation.error;
+  for (size_t k = 0; k < models_.size(); k++)
+    whitened.segment(k * dim_, dim_) *= sqrt(evaluation.weights(k));
+  return whitened;
+}
+
+/* ************************************************************************* */
+double MixtureFactor::error(const Values& x) const {
+  if (!active(x)) return 0.0;
+  const Evaluation evaluation = evaluate(x, false);
+  const Vector whitened = stackedR_ * evaluation.error;
+  const Eigen::Map<const Matrix> W(whitened.data(), dim_, models_.size());
+  const Vector distances = W.colwise().squaredNorm().transpose();
+  if (mode_ == MAX_MIXTURE) {
+    Vector::Index k;
+    evaluation.weights.maxCoeff(&k);
+    return 0.5 * distances(k) + offset(k);
+  }
+  return 0.5 * evaluation.weights.dot(distances);
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<GaussianFactor> MixtureFactor::linearize(
+    const Values& x) const {
+  if (!active(x)) return boost::shared_ptr<JacobianFactor>();
+  const Evaluation evaluation = evaluate(x, true);
+
+  // One product per key with the stacked square root informations whitens
+  // the shared Jacobians for all components, which are then weighted
+  const size_t K = models_.size();
+  vector<pair<Key, Matrix> > terms(size());
+  Vector b;
+  if (mode_ == MAX_MIXTURE) {
+    // The last row holds the offset, so that the error at zero is error(x)
+    Vector::Index k;
+    evaluation.weights.maxCoeff(&k);
+    const auto R = stackedR_.middleRows(k * dim_, dim_);
+    for (size_t j = 0; j < size(); j++) {
+      Matrix A = Matrix::Zero(dim_ + 1, evaluation.H[j].cols());
+      A.topRows(dim_) = R * evaluation.H[j];
+      terms[j] = make_pair(keys_[j], A);
+    }
+    b.resize(dim_ + 1);
+    b.head(dim_) = -(R * evaluation.error);
+    b(dim_) = sqrt(2.0 * offset(k));
+  } else {
+    const Vector sqrtWeights = evaluation.weights.array().sqrt();
+    for (size_t j = 0; j < size(); j++) {
+      Matrix A = stackedR_ * evaluation.H[j];
+      for (size_t k = 0; k < K; k++)
+        A.middleRows(k * dim_, dim_) *= sqrtWeights(k);
+      terms[j] = make_pair(keys_[j], A);
+    }
+    b = -(stackedR_ * evaluation.error);
+    for (size_t k = 0; k < K; k++)
+      b.segment(k * dim_, dim_) *= sqrtWeights(k);
+  }
+  return boost::make_shared<JacobianFactor>(terms, b,
+                                            noiseModel::Unit::Create(b.size()));
+}
+
+}  // namespace gtsam
@@ -0,0 +1,151 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MixtureFactor.h
+ * @brief   Base class for EM and max-mixture robust factors
+ */
+
+#pragma once
+
+#include <gtsam_unstable/dllexport.h>
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/linear/NoiseModel.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Base class for factors whose residual \f$ e(x) \f$ is explained by a mixture
+ * of zero-mean Gaussian components, e.g. an inlier and an outlier model as in
+ * BetweenFactorEM.  Derived classes only implement unwhitenedError(); the
+ * residual and its Jacobians are evaluated once and shared by all components.
+ *
+ * The component weights \f$ w_k \propto p_k N(e; 0, \Sigma_k) \f$ are computed
+ * for all components at once, from a single product with the stacked square
+ * root information matrices.  Two modes are supported:
+ *  - EM: the weights are held fixed (E-step) and the factor is the weighted
+ *    sum of the component errors, \f$ \sum_k w_k \|R_k e\|^2 / 2 \f$.
+ *  - MAX_MIXTURE: only the most likely component is used, with error
+ *    \f$ -\log(p_k N_k) \f$ up to a constant, see Olson and Agarwal, RSS 2012.
+ *    The difference of the normalization constants to the most concentrated
+ *    component is whitened as one extra row with a zero Jacobian, so that the
+ *    linearized error at zero equals error(), as the optimizers assume.
+ */
+class GTSAM_UNSTABLE_EXPORT MixtureFactor : public NonlinearFactor {
+ public:
+  enum Mode { EM, MAX_MIXTURE };
+
+ private:
+  typedef NonlinearFactor Base;
+
+  std::vector<noiseModel::Gaussian::shared_ptr> models_;
+  Vector priors_;
+  Mode mode_;
+  double minWeight_;
+
+  size_t dim_;              ///< dimension of the residual
+  Matrix stackedR_;         ///< square root informations, stacked vertically
+  Vector logNormalizers_;   ///< log(p_k |R_k|) for each component
+
+  /// Residual, weights and, if requested, Jacobians at given values
+  struct Evaluation {
+    Vector error;
+    Vector weights;
+    std::vector<Matrix> H;
+  };
+
+ public:
+  typedef boost::shared_ptr<MixtureFactor> shared_ptr;
+
+  /// Default constructor for serialization
+  MixtureFactor() : mode_(EM), minWeight_(0.0), dim_(0) {}
+
+  /**
+   * Constructor
+   * @param keys the variables the residual depends on
+   * @param models one Gaussian noise model per component, of equal dimension
+   * @param priors the prior probabilities of the components
+   * @param mode EM or MAX_MIXTURE
+   * @param minWeight weights are clamped to at least this value and
+   * renormalized, which keeps EM from switching off components entirely
+   */
+  MixtureFactor(const KeyVector& keys,
+                const std::vector<SharedGaussian>& models, const Vector& priors,
+                Mode mode = EM, double minWeight = 0.0);
+
+  virtual ~MixtureFactor() {}
+
+  /**
+   * The residual \f$ e(x) \f$, with one Jacobian per key if H is given.
+   */
+  virtual Vector unwhitenedError(
+      const Values& x,
+      boost::optional<std::vector<Matrix>&> H = boost::none) const = 0;
+
+  /// @name Testable
+  /// @{
+
+  virtual void print(const std::string& s = "",
+                     const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  virtual bool equals(const NonlinearFactor& f, double tol = 1e-9) const;
+
+  /// @}
+
+  /// The component weights (posterior probabilities) at x
+  Vector weights(const Values& x) const { return evaluate(x, false).weights; }
+
+  /// The component weights for a given residual, for all components at once
+  Vector weights(const Vector& error) const;
+
+  /// Index of the most likely component at x
+  size_t maxComponent(const Values& x) const;
+
+  /// The stacked whitened error: EM weighs all components, MAX_MIXTURE only
+  /// returns the most likely one, followed by its normalization offset
+  Vector whitenedError(const Values& x) const;
+
+  /// EM: \f$ \sum_k w_k \|R_k e\|^2 / 2 \f$, MAX_MIXTURE: the negative log
+  /// likelihood of the most likely component, offset to be non-negative
+  virtual double error(const Values& x) const;
+
+  /// Dimension of the linearized factor
+  virtual size_t dim() const {
+    return mode_ == EM ? dim_ * models_.size() : dim_ + 1;
+  }
+
+  /// Linearize with the weights held fixed, returning a whitened JacobianFactor
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const;
+
+  /// @name Access
+  /// @{
+
+  const std::vector<noiseModel::Gaussian::shared_ptr>& models() const {
+    return models_;
+  }
+  const Vector& priors() const { return priors_; }
+  Mode mode() const { return mode_; }
+
+  /// @}
+
+ private:
+  /// Evaluate e(x), the weights and, if requested, the Jacobians
+  Evaluation evaluate(const Values& x, bool jacobians) const;
+
+  /// MAX_MIXTURE error offset of component k, non-negative
+  double offset(size_t k) const {
+    return logNormalizers_.maxCoeff() - logNormalizers_(k);
+  }
+};
+
+}  // namespace gtsam
@@ -14,8 +14,8 @@
 #include <gtsam/inference/Key.h>
 #include <gtsam/geometry/Pose2.h>
 
-#include <list>
-#include <map>
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -28,19 +28,14 @@ namespace gtsam {
  */
 class SmartRangeFactor: public NoiseModelFactor {
  protected:
-  struct Circle2 {
-    Circle2(const Point2& p, double r) :
-        center(p), radius(r) {
-    }
-    Point2 center;
-    double radius;
-  };
-
   typedef SmartRangeFactor This;
 
   std::vector<double> measurements_;  ///< Range measurements
   double variance_;  ///< variance on noise
 
+  /// Number of Gauss-Newton iterations that refine the linear solution
+  static const size_t kRefinementIterations = 5;
+
  public:
   /** Default constructor: don't use directly */
   SmartRangeFactor() {
@@ -87,57 +82,79 @@ class SmartRangeFactor: public NoiseModelFactor {
   // factor interface
 
   /**
-   * Triangulate a point from at least three pose-range pairs
-   * Checks for best pair that includes first point
+   * Triangulate a point from at least three pose-range pairs.
+   * The squared range equations, minus their mean, are linear in the point,
+   * and their least-squares solution is refined with a fixed number of
+   * Gauss-Newton iterations on the range errors.  If all poses are collinear,
+   * the point is placed on the left of their line, seen from the first pose.
+   * The pose translations are read from x in each pass, and all temporaries
+   * are fixed-size, so no heap memory is used.  Nothing is cached, so the
+   * factor can be evaluated from several threads at once.
    * Raise runtime_error if not well defined.
    */
   Point2 triangulate(const Values& x) const {
-    // create n circles corresponding to measured range around each pose
-    std::list<Circle2> circles;
-    size_t n = size();
+    const size_t n = size();
+
+    // Work relative to the centroid c of the circle centers c_j:
+    // |q - d_j|^2 = r_j^2, with q = p - c and d_j = c_j - c. Subtracting the
+    // mean over j gives the linear equations -2 d_j'q = r_j^2 - |d_j|^2 - m,
+    // where m = mean(r_j^2 - |d_j|^2).
+    auto center = [&](size_t j) { return x.at<Pose2>(keys_[j]).translation(); };
+    Point2 centroid(0, 0);
+    for (size_t j = 0; j < n; j++) centroid += center(j);
+    centroid /= n;
+    double m = 0;
+    for (size_t j = 0; j < n; j++)
+      m += measurements_[j] * measurements_[j] -
+           (center(j) - centroid).squaredNorm();
+    m /= n;
+    Matrix2 AtA = Matrix2::Zero();
+    Vector2 Atb = Vector2::Zero();
     for (size_t j = 0; j < n; j++) {
-      const Pose2& pose = x.at<Pose2>(keys_[j]);
-      circles.push_back(Circle2(pose.translation(), measurements_[j]));
+      const Vector2 d = center(j) - centroid;
+      const double b =
+          measurements_[j] * measurements_[j] - d.squaredNorm() - m;
+      AtA += 4.0 * d * d.transpose();
+      Atb -= 2.0 * b * d;
     }
 
-    Circle2 circle1 = circles.front();
-    boost::optional<Point2> best_fh;
-    auto bestCircle2 = boost::make_optional(false, circle1);  // fixes issue #38
-
-    // loop over all circles
-    for (const Circle2& it : circles) {
-      // distance between circle centers.
-      double d = distance2(circle1.center, it.center);
-      if (d < 1e-9)
-        continue;  // skip circles that are in the same location
-      // Find f and h, the intersection points in normalized circles
-      boost::optional<Point2> fh = circleCircleIntersection(
-          circle1.radius / d, it.radius / d);
-      // Check if this pair is better by checking h = fh->y()
-      // if h is large, the intersections are well defined.
-      if (fh && (!best_fh || fh->y() > best_fh->y())) {
-        best_fh = fh;
-        bestCircle2 = it;
-      }
+    Eigen::SelfAdjointEigenSolver<Matrix2> eigen(AtA);
+    const Vector2& lambda = eigen.eigenvalues();  // in increasing order
+    if (lambda(1) < 1e-9) throw std::runtime_error("triangulate failed");
+    Point2 q;
+    if (lambda(0) > 1e-9 * lambda(1)) {
+      q = eigen.eigenvectors() * (eigen.eigenvectors().transpose() * Atb)
+          .cwiseQuotient(lambda);
+    } else {
+      // Collinear centers: the linear equations only determine the position
+      // along the line, the offset h from it follows from the ranges
+      Vector2 along = eigen.eigenvectors().col(1);
+      if (along.dot(center(0) - centroid) > 0) along = -along;
+      q = along * along.dot(Atb) / lambda(1);
+      double h2 = 0;
+      for (size_t j = 0; j < n; j++)
+        h2 += measurements_[j] * measurements_[j] -
+              (q - center(j) + centroid).squaredNorm();
+      q += std::sqrt(std::max(h2 / n, 0.0)) * Vector2(-along.y(), along.x());
     }
+    Point2 point = centroid + q;
 
-    // use best fh to find actual intersection points
-    if (bestCircle2 && best_fh) {
-      auto bestCircleCenter = bestCircle2->center;
-      std::list<Point2> intersections =
-          circleCircleIntersection(circle1.center, bestCircleCenter, best_fh);
-
-      // pick winner based on other measurements
-      double error1 = 0, error2 = 0;
-      Point2 p1 = intersections.front(), p2 = intersections.back();
-      for (const Circle2& it : circles) {
-        error1 += distance2(it.center, p1);
-        error2 += distance2(it.center, p2);
+    // Gauss-Newton on the range errors |p - c_j| - r_j
+    for (size_t i = 0; i < kRefinementIterations; i++) {
+      Matrix2 JtJ = Matrix2::Zero();
+      Vector2 Jte = Vector2::Zero();
+      for (size_t j = 0; j < n; j++) {
+        const Vector2 d = point - center(j);
+        const double range = d.norm();
+        if (range < 1e-9) continue;
+        const Vector2 J = d / range;
+        JtJ += J * J.transpose();
+        Jte += J * (range - measurements_[j]);
       }
-      return (error1 < error2) ? p1 : p2;
-    } else {
-      throw std::runtime_error("triangulate failed");
+      if (JtJ.determinant() < 1e-9) break;
+      point -= JtJ.inverse() * Jte;
     }
+    return point;
   }
 
   /**
@@ -179,6 +196,8 @@ class SmartRangeFactor: public NoiseModelFactor {
     return boost::static_pointer_cast<gtsam::NonlinearFactor>(
         gtsam::NonlinearFactor::shared_ptr(new This(*this)));
   }
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
 }  // \namespace gtsam
 
@@ -61,6 +61,60 @@ TEST( EquivInertialNavFactor_GlobalVel, Constructor)
 
 }
 
+/* ************************************************************************* */
+TEST( EquivInertialNavFactor_GlobalVel, Jacobians)
+{
+  typedef EquivInertialNavFactor_GlobalVel<Pose3, Vector3, imuBias::ConstantBias> Factor;
+
+  // IMU accumulation variables, with a non-trivial dependence on the bias
+  Vector delta_pos_in_t0 = Vector3(0.1, -0.05, 0.02);
+  Vector delta_vel_in_t0 = Vector3(0.5, 0.1, -0.2);
+  Vector3 delta_angles(0.02, -0.01, 0.05);
+  double delta_t = 0.1;
+  Matrix Jacobian_wrt_t0_Overall = Matrix::Identity(15,15);
+  Jacobian_wrt_t0_Overall.block(4,9,3,6) << 0.1, 0.2, 0.0, 0.3, 0.0, 0.1,
+                                            0.0, 0.1, 0.2, 0.0, 0.2, 0.3,
+                                            0.2, 0.0, 0.1, 0.1, 0.3, 0.0;
+  Jacobian_wrt_t0_Overall.block(6,9,3,6) = 2 * Jacobian_wrt_t0_Overall.block(4,9,3,6);
+  Jacobian_wrt_t0_Overall.block(0,12,3,3) << 0.1, 0.0, 0.2, 0.0, 0.1, 0.0, 0.3, 0.0, 0.1;
+  imuBias::ConstantBias bias_initial(Vector3(0.01, 0.02, 0.03), Vector3(0.001, 0.002, 0.003));
+
+  // Earth Terms (gravity, etc)
+  Vector3 g(0.0, 0.0, -9.80);
+  Vector3 rho(0.0, 0.0, 1e-3);
+  Vector3 omega_earth(1e-4, 0.0, 7e-5);
+
+  SharedGaussian imu_model = noiseModel::Isotropic::Sigma(9, 0.1);
+  Factor factor(11, 21, 31, 12, 22, delta_pos_in_t0, delta_vel_in_t0, delta_angles,
+      delta_t, g, rho, omega_earth, imu_model, Jacobian_wrt_t0_Overall, bias_initial);
+
+  Pose3 Pose1(Rot3::RzRyRx(0.1, -0.2, 0.3), Point3(1.0, 2.0, 3.0));
+  Vector3 Vel1(1.0, 0.5, -0.2);
+  imuBias::ConstantBias Bias1(Vector3(0.05, -0.02, 0.01), Vector3(0.01, 0.0, -0.02));
+  Pose3 Pose2(Rot3::RzRyRx(0.12, -0.21, 0.36), Point3(1.2, 2.1, 2.9));
+  Vector3 Vel2(1.1, 0.4, -1.1);
+
+  boost::function<Vector(const Pose3&, const Vector3&, const imuBias::ConstantBias&,
+      const Pose3&, const Vector3&)> error =
+      [&](const Pose3& p1, const Vector3& v1, const imuBias::ConstantBias& b1,
+          const Pose3& p2, const Vector3& v2) {
+        return factor.evaluateError(p1, v1, b1, p2, v2);
+      };
+
+  Matrix H1, H2, H3, H4, H5;
+  factor.evaluateError(Pose1, Vel1, Bias1, Pose2, Vel2, H1, H2, H3, H4, H5);
+  EXPECT(assert_equal(numericalDerivative51<Vector, Pose3, Vector3, imuBias::ConstantBias, Pose3, Vector3>(
+      error, Pose1, Vel1, Bias1, Pose2, Vel2), H1, 1e-6));
+  EXPECT(assert_equal(numericalDerivative52<Vector, Pose3, Vector3, imuBias::ConstantBias, Pose3, Vector3>(
+      error, Pose1, Vel1, Bias1, Pose2, Vel2), H2, 1e-6));
+  EXPECT(assert_equal(numericalDerivative53<Vector, Pose3, Vector3, imuBias::ConstantBias, Pose3, Vector3>(
+      error, Pose1, Vel1, Bias1, Pose2, Vel2), H3, 1e-6));
+  EXPECT(assert_equal(numericalDerivative54<Vector, Pose3, Vector3, imuBias::ConstantBias, Pose3, Vector3>(
+      error, Pose1, Vel1, Bias1, Pose2, Vel2), H4, 1e-6));
+  EXPECT(assert_equal(numericalDerivative55<Vector, Pose3, Vector3, imuBias::ConstantBias, Pose3, Vector3>(
+      error, Pose1, Vel1, Bias1, Pose2, Vel2), H5, 1e-6));
+}
+
 /* ************************************************************************* */
   int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -0,0 +1,79 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testEquivInertialNavFactor_GlobalVel_NoBias.cpp
+ * @brief   Unit test for the EquivInertialNavFactor_GlobalVel_NoBias
+ */
+
+#include <gtsam_unstable/slam/EquivInertialNavFactor_GlobalVel_NoBias.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/base/numericalDerivative.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+// Instantiate all members, not only those used below
+template class gtsam::EquivInertialNavFactor_GlobalVel_NoBias<Pose3, Vector3>;
+
+/* ************************************************************************* */
+TEST( EquivInertialNavFactor_GlobalVel_NoBias, Jacobians)
+{
+  typedef EquivInertialNavFactor_GlobalVel_NoBias<Pose3, Vector3> Factor;
+
+  // IMU accumulation variables
+  Vector delta_pos_in_t0 = Vector3(0.1, -0.05, 0.02);
+  Vector delta_vel_in_t0 = Vector3(0.5, 0.1, -0.2);
+  Vector3 delta_angles(0.02, -0.01, 0.05);
+  double delta_t = 0.1;
+  Matrix Jacobian_wrt_t0_Overall = Matrix::Identity(9,9);
+
+  // Earth Terms (gravity, etc)
+  Vector3 g(0.0, 0.0, -9.80);
+  Vector3 rho(0.0, 0.0, 1e-3);
+  Vector3 omega_earth(1e-4, 0.0, 7e-5);
+
+  noiseModel::Gaussian::shared_ptr imu_model = noiseModel::Isotropic::Sigma(9, 0.1);
+  Factor factor(11, 21, 12, 22, delta_pos_in_t0, delta_vel_in_t0, delta_angles,
+      delta_t, g, rho, omega_earth, imu_model, Jacobian_wrt_t0_Overall);
+
+  Pose3 Pose1(Rot3::RzRyRx(0.1, -0.2, 0.3), Point3(1.0, 2.0, 3.0));
+  Vector3 Vel1(1.0, 0.5, -0.2);
+  Pose3 Pose2(Rot3::RzRyRx(0.12, -0.21, 0.36), Point3(1.2, 2.1, 2.9));
+  Vector3 Vel2(1.1, 0.4, -1.1);
+
+  // The error is that of the predicted pose and velocity
+  Vector9 expected;
+  expected << Pose3::Logmap(Pose2.between(factor.predictPose(Pose1, Vel1))),
+              factor.predictVelocity(Pose1, Vel1) - Vel2;
+  EXPECT(assert_equal(Vector(expected), factor.evaluateError(Pose1, Vel1, Pose2, Vel2), 1e-9));
+
+  boost::function<Vector(const Pose3&, const Vector3&, const Pose3&, const Vector3&)> error =
+      [&](const Pose3& p1, const Vector3& v1, const Pose3& p2, const Vector3& v2) {
+        return factor.evaluateError(p1, v1, p2, v2);
+      };
+
+  Matrix H1, H2, H3, H4;
+  factor.evaluateError(Pose1, Vel1, Pose2, Vel2, H1, H2, H3, H4);
+  EXPECT(assert_equal(numericalDerivative41<Vector, Pose3, Vector3, Pose3, Vector3>(
+      error, Pose1, Vel1, Pose2, Vel2), H1, 1e-6));
+  EXPECT(assert_equal(numericalDerivative42<Vector, Pose3, Vector3, Pose3, Vector3>(
+      error, Pose1, Vel1, Pose2, Vel2), H2, 1e-6));
+  EXPECT(assert_equal(numericalDerivative43<Vector, Pose3, Vector3, Pose3, Vector3>(
+      error, Pose1, Vel1, Pose2, Vel2), H3, 1e-6));
+  EXPECT(assert_equal(numericalDerivative44<Vector, Pose3, Vector3, Pose3, Vector3>(
+      error, Pose1, Vel1, Pose2, Vel2), H4, 1e-6));
+}
+
+/* ************************************************************************* */
+  int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
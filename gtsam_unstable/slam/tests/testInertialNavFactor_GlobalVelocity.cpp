@@ -38,10 +38,10 @@ static const Vector3 world_omega_earth = world_R_ECEF.matrix()
     * ECEF_omega_earth;
 
 /* ************************************************************************* */
-Pose3 predictionErrorPose(const Pose3& p1, const Vector3& v1,
+Vector predictionErrorPose(const Pose3& p1, const Vector3& v1,
     const imuBias::ConstantBias& b1, const Pose3& p2, const Vector3& v2,
     const InertialNavFactor_GlobalVelocity<Pose3, Vector3, imuBias::ConstantBias>& factor) {
-  return Pose3::Expmap(factor.evaluateError(p1, v1, b1, p2, v2).head(6));
+  return factor.evaluateError(p1, v1, b1, p2, v2).head(6);
 }
 
 Vector predictionErrorVel(const Pose3& p1, const Vector3& v1,
@@ -309,26 +309,26 @@ Vector predictionErrorVel(const Pose3& p1, const Vector3& v1,
   // Calculate the Jacobian matrices H1 until H5 using the numerical derivative function
   Matrix H1_expectedPose, H2_expectedPose, H3_expectedPose, H4_expectedPose,
       H5_expectedPose;
-  H1_expectedPose = numericalDerivative11<Pose3, Pose3>(
+  H1_expectedPose = numericalDerivative11<Vector, Pose3>(
       boost::bind(&predictionErrorPose, _1, Vel1, Bias1, Pose2, Vel2, factor),
       Pose1);
-  H2_expectedPose = numericalDerivative11<Pose3, Vector3>(
+  H2_expectedPose = numericalDerivative11<Vector, Vector3>(
       boost::bind(&predictionErrorPose, Pose1, _1, Bias1, Pose2, Vel2, factor),
       Vel1);
-  H3_expectedPose = numericalDerivative11<Pose3, imuBias::ConstantBias>(
+  H3_expectedPose = numericalDerivative11<Vector, imuBias::ConstantBias>(
       boost::bind(&predictionErrorPose, Pose1, Vel1, _1, Pose2, Vel2, factor),
       Bias1);
-  H4_expectedPose = numericalDerivative11<Pose3, Pose3>(
+  H4_expectedPose = numericalDerivative11<Vector, Pose3>(
       boost::bind(&predictionErrorPose, Pose1, Vel1, Bias1, _1, Vel2, factor),
       Pose2);
-  H5_expectedPose = numericalDerivative11<Pose3, Vector3>(
+  H5_expectedPose = numericalDerivative11<Vector, Vector3>(
       boost::bind(&predictionErrorPose, Pose1, Vel1, Bias1, Pose2, _1, factor),
       Vel2);
 
   // Verify they are equal for this choice of state
   CHECK( assert_equal(H1_expectedPose, H1_actualPose, 1e-5));
   CHECK( assert_equal(H2_expectedPose, H2_actualPose, 1e-5));
-  CHECK( assert_equal(H3_expectedPose, H3_actualPose, 2e-3));
+  CHECK( assert_equal(H3_expectedPose, H3_actualPose, 1e-5));
   CHECK( assert_equal(H4_expectedPose, H4_actualPose, 1e-5));
   CHECK( assert_equal(H5_expectedPose, H5_actualPose, 1e-5));
 
@@ -641,26 +641,26 @@ Vector predictionErrorVel(const Pose3& p1, const Vector3& v1,
   // Calculate the Jacobian matrices H1 until H5 using the numerical derivative function
   Matrix H1_expectedPose, H2_expectedPose, H3_expectedPose, H4_expectedPose,
       H5_expectedPose;
-  H1_expectedPose = numericalDerivative11<Pose3, Pose3>(
+  H1_expectedPose = numericalDerivative11<Vector, Pose3>(
       boost::bind(&predictionErrorPose, _1, Vel1, Bias1, Pose2, Vel2, factor),
       Pose1);
-  H2_expectedPose = numericalDerivative11<Pose3, Vector3>(
+  H2_expectedPose = numericalDerivative11<Vector, Vector3>(
       boost::bind(&predictionErrorPose, Pose1, _1, Bias1, Pose2, Vel2, factor),
       Vel1);
-  H3_expectedPose = numericalDerivative11<Pose3, imuBias::ConstantBias>(
+  H3_expectedPose = numericalDerivative11<Vector, imuBias::ConstantBias>(
       boost::bind(&predictionErrorPose, Pose1, Vel1, _1, Pose2, Vel2, factor),
       Bias1);
-  H4_expectedPose = numericalDerivative11<Pose3, Pose3>(
+  H4_expectedPose = numericalDerivative11<Vector, Pose3>(
       boost::bind(&predictionErrorPose, Pose1, Vel1, Bias1, _1, Vel2, factor),
       Pose2);
-  H5_expectedPose = numericalDerivative11<Pose3, Vector3>(
+  H5_expectedPose = numericalDerivative11<Vector, Vector3>(
       boost::bind(&predictionErrorPose, Pose1, Vel1, Bias1, Pose2, _1, factor),
       Vel2);
 
   // Verify they are equal for this choice of state
   CHECK( assert_equal(H1_expectedPose, H1_actualPose, 1e-5));
   CHECK( assert_equal(H2_expectedPose, H2_actualPose, 1e-5));
-  CHECK( assert_equal(H3_expectedPose, H3_actualPose, 2e-3));
+  CHECK( assert_equal(H3_expectedPose, H3_actualPose, 1e-5));
   CHECK( assert_equal(H4_expectedPose, H4_actualPose, 1e-5));
   CHECK( assert_equal(H5_expectedPose, H5_actualPose, 1e-5));
 
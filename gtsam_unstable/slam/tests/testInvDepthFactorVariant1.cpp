@@ -16,6 +16,7 @@
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Point3.h>
 #include <gtsam/geometry/Point2.h>
+#include <gtsam/base/numericalDerivative.h>
 
 using namespace std;
 using namespace gtsam;
@@ -123,6 +124,24 @@ TEST( InvDepthFactorVariant1, optimize) {
 }
 
 
+/* ************************************************************************* */
+TEST( InvDepthFactorVariant1, Jacobians) {
+  // A camera looking roughly along the x-direction, and a landmark in front of it
+  Pose3 pose(Rot3::Ypr(-M_PI/2 + 0.1, 0.05, -M_PI/2 - 0.05), Point3(0.1, -0.2, 1.0));
+  Cal3_S2::shared_ptr K(new Cal3_S2(1500, 1200, 0, 640, 480));
+  SharedNoiseModel sigma(noiseModel::Unit::Create(2));
+  InvDepthFactorVariant1 factor(1, 100, Point2(650, 470), K, sigma);
+  Vector6 landmark;
+  landmark << 0.5, 0.2, 1.1, 0.1, 0.05, 0.2;
+
+  Matrix H1, H2;
+  factor.evaluateError(pose, landmark, H1, H2);
+  boost::function<Vector(const Pose3&, const Vector6&)> error =
+      [&](const Pose3& p, const Vector6& l) { return factor.evaluateError(p, l); };
+  EXPECT(assert_equal(numericalDerivative21(error, pose, landmark), H1, 1e-5));
+  EXPECT(assert_equal(numericalDerivative22(error, pose, landmark), H2, 1e-5));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -16,6 +16,7 @@
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Point3.h>
 #include <gtsam/geometry/Point2.h>
+#include <gtsam/base/numericalDerivative.h>
 
 using namespace std;
 using namespace gtsam;
@@ -110,6 +111,23 @@ TEST( InvDepthFactorVariant2, optimize) {
 }
 
 
+/* ************************************************************************* */
+TEST( InvDepthFactorVariant2, Jacobians) {
+  // A camera looking roughly along the x-direction, and a landmark in front of it
+  Pose3 pose(Rot3::Ypr(-M_PI/2 + 0.1, 0.05, -M_PI/2 - 0.05), Point3(0.1, -0.2, 1.0));
+  Cal3_S2::shared_ptr K(new Cal3_S2(1500, 1200, 0, 640, 480));
+  SharedNoiseModel sigma(noiseModel::Unit::Create(2));
+  InvDepthFactorVariant2 factor(1, 100, Point2(650, 470), K, Point3(0.5, 0.2, 1.1), sigma);
+  Vector3 landmark(0.1, 0.05, 0.2);
+
+  Matrix H1, H2;
+  factor.evaluateError(pose, landmark, H1, H2);
+  boost::function<Vector(const Pose3&, const Vector3&)> error =
+      [&](const Pose3& p, const Vector3& l) { return factor.evaluateError(p, l); };
+  EXPECT(assert_equal(numericalDerivative21(error, pose, landmark), H1, 1e-5));
+  EXPECT(assert_equal(numericalDerivative22(error, pose, landmark), H2, 1e-5));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
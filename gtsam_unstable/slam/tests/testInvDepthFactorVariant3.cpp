@@ -16,6 +16,7 @@
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Point3.h>
 #include <gtsam/geometry/Point2.h>
+#include <gtsam/base/numericalDerivative.h>
 
 using namespace std;
 using namespace gtsam;
@@ -80,6 +81,34 @@ TEST( InvDepthFactorVariant3, optimize) {
 }
 
 
+/* ************************************************************************* */
+TEST( InvDepthFactorVariant3, Jacobians) {
+  // A camera looking roughly along the x-direction, and a landmark in front of it
+  Pose3 pose(Rot3::Ypr(-M_PI/2 + 0.1, 0.05, -M_PI/2 - 0.05), Point3(0.1, -0.2, 1.0));
+  Cal3_S2::shared_ptr K(new Cal3_S2(1500, 1200, 0, 640, 480));
+  SharedNoiseModel sigma(noiseModel::Unit::Create(2));
+  Pose3 pose2 = pose.compose(Pose3(Rot3::Ypr(0.02, -0.01, 0.03), Point3(0.2, 0.1, -0.3)));
+  Vector3 landmark(0.1, 0.05, 0.2);
+
+  InvDepthFactorVariant3a factor3a(1, 100, Point2(650, 470), K, sigma);
+  Matrix H1, H2, H3;
+  factor3a.evaluateError(pose, landmark, H1, H2);
+  boost::function<Vector(const Pose3&, const Vector3&)> error3a =
+      [&](const Pose3& p, const Vector3& l) { return factor3a.evaluateError(p, l); };
+  EXPECT(assert_equal(numericalDerivative21(error3a, pose, landmark), H1, 1e-5));
+  EXPECT(assert_equal(numericalDerivative22(error3a, pose, landmark), H2, 1e-5));
+
+  InvDepthFactorVariant3b factor3b(1, 2, 100, Point2(650, 470), K, sigma);
+  factor3b.evaluateError(pose, pose2, landmark, H1, H2, H3);
+  boost::function<Vector(const Pose3&, const Pose3&, const Vector3&)> error3b =
+      [&](const Pose3& p1, const Pose3& p2, const Vector3& l) {
+        return factor3b.evaluateError(p1, p2, l);
+      };
+  EXPECT(assert_equal(numericalDerivative31(error3b, pose, pose2, landmark), H1, 1e-5));
+  EXPECT(assert_equal(numericalDerivative32(error3b, pose, pose2, landmark), H2, 1e-5));
+  EXPECT(assert_equal(numericalDerivative33(error3b, pose, pose2, landmark), H3, 1e-5));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -0,0 +1,137 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testMixtureFactor.cpp
+ * @brief   Unit tests for MixtureFactor and BetweenFactorMixture
+ */
+
+#include <gtsam_unstable/slam/BetweenFactorMixture.h>
+#include <gtsam_unstable/slam/BetweenFactorEM.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+const Pose2 p1(10.0, 15.0, 0.1), p2(15.0, 15.0, 0.3);
+const Pose2 measured = p1.between(p2).compose(Pose2(0.5, 0.4, 0.01));
+const SharedGaussian inlier =
+    noiseModel::Diagonal::Sigmas(Vector3(0.5, 0.5, 0.05));
+const SharedGaussian outlier =
+    noiseModel::Diagonal::Sigmas(Vector3(5, 5, 1.0));
+const vector<SharedGaussian> models = {inlier, outlier};
+
+Values createValues(const Pose2& x2) {
+  Values values;
+  values.insert(1, p1);
+  values.insert(2, x2);
+  return values;
+}
+
+// Error of a linearized factor at zero, i.e., at the linearization point
+double errorAtZero(const GaussianFactor& factor) {
+  VectorValues zero;
+  for (GaussianFactor::const_iterator it = factor.begin(); it != factor.end();
+       ++it)
+    zero.insert(*it, Vector::Zero(factor.getDim(it)));
+  return factor.error(zero);
+}
+}  // namespace
+
+/* ************************************************************************* */
+// EM mode agrees with BetweenFactorEM
+TEST(MixtureFactor, EM) {
+  BetweenFactorMixture<Pose2> f(1, 2, measured, models, Vector2(0.7, 0.3),
+                                MixtureFactor::EM, 0.05);
+  BetweenFactorEM<Pose2> expected(1, 2, measured, inlier, outlier, 0.7, 0.3,
+                                  true);
+  EXPECT_LONGS_EQUAL(6, f.dim());
+
+  for (const Pose2& x2 : {p2, measured, Pose2(20, 13, 1.2)}) {
+    const Values values = createValues(x2);
+    EXPECT(assert_equal(expected.calcIndicatorProb(values), f.weights(values)));
+    EXPECT(assert_equal(expected.whitenedError(values), f.whitenedError(values)));
+    EXPECT_DOUBLES_EQUAL(0.5 * expected.error(values), f.error(values), 1e-9);
+
+    GaussianFactor::shared_ptr actual = f.linearize(values);
+    EXPECT(assert_equal(*expected.linearize(values), *actual, 1e-9));
+    EXPECT_DOUBLES_EQUAL(f.error(values), errorAtZero(*actual), 1e-9);
+  }
+}
+
+/* ************************************************************************* */
+// MAX_MIXTURE mode behaves like the most likely component
+TEST(MixtureFactor, MaxMixture) {
+  BetweenFactorMixture<Pose2> f(1, 2, measured, models, Vector2(0.9, 0.1),
+                                MixtureFactor::MAX_MIXTURE);
+  EXPECT_LONGS_EQUAL(4, f.dim());
+
+  // Close to the measurement the inlier model wins and the error is that of
+  // a regular BetweenFactor, the offset row is zero
+  Values values = createValues(p2);
+  EXPECT_LONGS_EQUAL(0, f.maxComponent(values));
+  BetweenFactor<Pose2> inlierFactor(1, 2, measured, inlier);
+  EXPECT_DOUBLES_EQUAL(inlierFactor.error(values), f.error(values), 1e-9);
+  GaussianFactor::shared_ptr actual = f.linearize(values);
+  Matrix Ab = actual->augmentedJacobian();
+  EXPECT(assert_equal(inlierFactor.linearize(values)->augmentedJacobian(),
+                      Matrix(Ab.topRows(3)), 1e-9));
+  EXPECT(assert_equal(Vector(Vector::Zero(7)), Vector(Ab.row(3)), 1e-9));
+  EXPECT_DOUBLES_EQUAL(f.error(values), errorAtZero(*actual), 1e-9);
+
+  // Far away the outlier model wins, and the error includes the difference
+  // of the normalization constants
+  values = createValues(Pose2(20, 13, 1.2));
+  EXPECT_LONGS_EQUAL(1, f.maxComponent(values));
+  BetweenFactor<Pose2> outlierFactor(1, 2, measured, outlier);
+  const double logRatio =
+      log(0.9 / 0.1) + log(inlier->R().determinant() / outlier->R().determinant());
+  EXPECT_DOUBLES_EQUAL(outlierFactor.error(values) + logRatio, f.error(values),
+                       1e-9);
+
+  // The linearization keeps that constant in its last row
+  actual = f.linearize(values);
+  Ab = actual->augmentedJacobian();
+  EXPECT(assert_equal(outlierFactor.linearize(values)->augmentedJacobian(),
+                      Matrix(Ab.topRows(3)), 1e-9));
+  Vector expectedRow = Vector::Zero(7);
+  expectedRow(6) = sqrt(2.0 * logRatio);
+  EXPECT(assert_equal(expectedRow, Vector(Ab.row(3)), 1e-9));
+  EXPECT_DOUBLES_EQUAL(f.error(values), errorAtZero(*actual), 1e-9);
+  EXPECT_DOUBLES_EQUAL(f.error(values),
+                       0.5 * f.whitenedError(values).squaredNorm(), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(MixtureFactor, Equals) {
+  BetweenFactorMixture<Pose2> f(1, 2, measured, models, Vector2(0.7, 0.3));
+  BetweenFactorMixture<Pose2> g(1, 2, measured, models, Vector2(0.7, 0.3));
+  BetweenFactorMixture<Pose2> h(1, 2, measured, models, Vector2(0.7, 0.3),
+                                MixtureFactor::MAX_MIXTURE);
+  EXPECT(assert_equal(f, g));
+  EXPECT(!f.equals(h));
+  CHECK_EXCEPTION(BetweenFactorMixture<Pose2>(1, 2, measured, models,
+                                              Vector1(1.0)),
+                  std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -108,7 +108,20 @@ TEST( SmartRangeFactor, optimization ) {
   initial.insert(2, pose2);
   initial.insert(3, Pose2(5, 6, 0)); // does not satisfy range measurement
   Vector actual5 = f.unwhitenedError(initial);
-  EXPECT(assert_equal((Vector(1) << sqrt(25.0+16.0)-sqrt(50.0)).finished(), actual5));
+
+  // The triangulated point minimizes the squared range errors
+  Point2 point = f.triangulate(initial);
+  const double ranges[] = {r1, r2, r3};
+  Vector2 gradient(0, 0);
+  double expected5 = 0;
+  for (size_t j = 0; j < 3; j++) {
+    const Pose2& pose = initial.at<Pose2>(j + 1);
+    const double error = pose.range(point) - ranges[j];
+    gradient += error * (point - pose.translation()) / pose.range(point);
+    expected5 += error;
+  }
+  EXPECT(assert_equal(Vector2(0, 0), gradient, 1e-9));
+  EXPECT(assert_equal((Vector(1) << expected5).finished(), actual5));
 
   // Create Factor graph
   NonlinearFactorGraph graph;
@@ -123,10 +136,33 @@ TEST( SmartRangeFactor, optimization ) {
   //  params.setVerbosity("ERROR");
   LevenbergMarquardtOptimizer optimizer(graph, initial, params);
   Values result = optimizer.optimize();
-  EXPECT(assert_equal(initial.at<Pose2>(1), result.at<Pose2>(1)));
-  EXPECT(assert_equal(initial.at<Pose2>(2), result.at<Pose2>(2)));
-  // only the third pose will be changed, converges on following:
-  EXPECT(assert_equal(Pose2(5.52159, 5.582727, 0), result.at<Pose2>(3),1e-5));
+  EXPECT(assert_equal(initial.at<Pose2>(1), result.at<Pose2>(1), 1e-5));
+  EXPECT(assert_equal(initial.at<Pose2>(2), result.at<Pose2>(2), 1e-5));
+  // mostly the third pose will be changed, converges on following:
+  EXPECT(assert_equal(Pose2(5.021717, 5.985584, 0), result.at<Pose2>(3),1e-5));
+}
+
+TEST( SmartRangeFactor, triangulate ) {
+  // Poses on a line: the point is placed on the left
+  Values values;
+  values.insert(1, Pose2(0, 0, 0));
+  values.insert(2, Pose2(5, 0, 0));
+  values.insert(3, Pose2(10, 0, 0));
+  SmartRangeFactor f(sigma);
+  f.addRange(1, Point2(0, 0).distance(p));
+  f.addRange(2, Point2(5, 0).distance(p));
+  f.addRange(3, Point2(10, 0).distance(p));
+  EXPECT(assert_equal(p, f.triangulate(values), 1e-9));
+
+  // The current poses are used: moving the third pose off the line, to a
+  // place at the same range from p, gives p again
+  values.update(3, Pose2(10, 20, 0));
+  EXPECT(assert_equal(p, f.triangulate(values), 1e-9));
+
+  // All poses in the same location
+  Values same;
+  for (size_t j = 1; j <= 3; j++) same.insert(j, pose1);
+  CHECK_EXCEPTION(f.triangulate(same), std::runtime_error);
 }
 
 /* ************************************************************************* */
@@ -20,6 +20,7 @@
 #include <gtsam/base/DSFVector.h>
 #include <gtsam_unstable/base/DSF.h>
 #include <gtsam/base/DSFMap.h>
+#include <gtsam/base/ConcurrentDSF.h>
 
 #include <boost/format.hpp>
 #include <boost/assign/std/vector.hpp>
@@ -39,7 +40,7 @@ int main(int argc, char* argv[]) {
 
   // Create CSV file for results
   ofstream os("dsf-timing.csv");
-  os << "images,points,matches,Base,Map,BTree" << endl;
+  os << "images,points,matches,Base,Map,Concurrent" << endl;
 
   // loop over number of images
   vector<size_t> ms;
@@ -94,11 +95,27 @@ int main(int argc, char* argv[]) {
       gttoc_(dsftime);
       tictoc_getNode(dsftimeNode, dsftime);
       dsftime = dsftimeNode->secs();
-      os << dsftime << endl;
+      os << dsftime << ",";
       cout << format("DSFMap: %1% s") % dsftime << endl;
       tictoc_reset_();
     }
 
+    {
+      // ConcurrentDSF version, parallel merges and set extraction with TBB
+      double dsftime = 0;
+      gttic_(dsftime);
+      ConcurrentDSF dsf(N);
+      dsf.merge(matches);
+      vector<vector<size_t> > sets = dsf.sets();
+      gttoc_(dsftime);
+      tictoc_getNode(dsftimeNode, dsftime);
+      dsftime = dsftimeNode->secs();
+      os << dsftime << endl;
+      cout << format("ConcurrentDSF: %1% s (%2% sets)") % dsftime % sets.size()
+           << endl;
+      tictoc_reset_();
+    }
+
     if (false) {
       // DSF version, functional
       double dsftime = 0;
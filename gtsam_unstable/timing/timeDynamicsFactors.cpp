@@ -0,0 +1,88 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeDynamicsFactors.cpp
+ * @brief   Time linearization of the PoseRTV dynamics factors, comparing the
+ *          analytic Jacobians with the numerical derivatives used before
+ */
+
+#include <gtsam_unstable/dynamics/IMUFactor.h>
+#include <gtsam_unstable/dynamics/FullIMUFactor.h>
+#include <gtsam_unstable/dynamics/VelocityConstraint.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/base/numericalDerivative.h>
+#include <gtsam/base/timing.h>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t n = 100000;
+typedef boost::function<Vector(const PoseRTV&, const PoseRTV&)> ErrorFunction;
+
+/* ************************************************************************* */
+// Time numerical (previous implementation) and analytic Jacobians of a factor
+template<class FACTOR>
+void timeFactor(const string& name, const FACTOR& factor, const PoseRTV& x1,
+    const PoseRTV& x2, const Values& values) {
+  ErrorFunction f = [&](const PoseRTV& a, const PoseRTV& b) {
+    return factor.evaluateError(a, b);
+  };
+
+  Matrix H1, H2;
+  gttic_(numerical);
+  for (size_t i = 0; i < n; ++i) {
+    H1 = numericalDerivative21(f, x1, x2, 1e-5);
+    H2 = numericalDerivative22(f, x1, x2, 1e-5);
+    factor.evaluateError(x1, x2);
+  }
+  gttoc_(numerical);
+
+  gttic_(analytic);
+  for (size_t i = 0; i < n; ++i)
+    factor.evaluateError(x1, x2, H1, H2);
+  gttoc_(analytic);
+
+  gttic_(linearize);
+  for (size_t i = 0; i < n; ++i)
+    factor.linearize(values);
+  gttoc_(linearize);
+
+  cout << name << endl;
+  tictoc_finishedIteration_();
+  tictoc_print_();
+  tictoc_reset_();
+}
+
+/* ************************************************************************* */
+int main() {
+  const double dt = 0.1;
+  const Key key1 = 1, key2 = 2;
+  PoseRTV x1(Point3(0.5, 0.2, 0.1), Rot3::RzRyRx(0.1, 0.2, 0.3), Velocity3(1.0, 0.5, 0.2));
+  PoseRTV x2(Point3(0.6, 0.2, 0.1), Rot3::RzRyRx(0.12, 0.18, 0.33), Velocity3(0.9, 0.6, 0.2));
+  Values values;
+  values.insert(key1, x1);
+  values.insert(key2, x2);
+  Vector6 imu = x1.imuPrediction(x2, dt);
+
+  timeFactor("IMUFactor",
+      IMUFactor<PoseRTV>(imu, dt, key1, key2, noiseModel::Isotropic::Sigma(6, 0.1)),
+      x1, x2, values);
+  timeFactor("FullIMUFactor",
+      FullIMUFactor<PoseRTV>(imu, dt, key1, key2, noiseModel::Isotropic::Sigma(9, 0.1)),
+      x1, x2, values);
+  timeFactor("VelocityConstraint",
+      VelocityConstraint(key1, key2, dt, noiseModel::Isotropic::Sigma(3, 0.1)),
+      x1, x2, values);
+  return 0;
+}
+
+/* ************************************************************************* */
@@ -18,6 +18,7 @@
 #include <iostream>
 #include <gtsam/navigation/ImuBias.h>
 #include <gtsam_unstable/slam/InertialNavFactor_GlobalVelocity.h>
+#include <gtsam_unstable/slam/EquivInertialNavFactor_GlobalVel.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/base/numericalDerivative.h>
@@ -43,6 +44,37 @@ gtsam::Vector3 predictionErrorVel(const Pose3& p1, const Vector3& v1, const imuB
   return factor.evaluateError(p1, v1, b1, p2, v2).tail(3);
 }
 
+typedef boost::function<Vector(const Pose3&, const Vector3&,
+    const imuBias::ConstantBias&, const Pose3&, const Vector3&)> ErrorFunction;
+
+/* ************************************************************************* */
+// Time the Jacobians by numerical differentiation, as computed before, and
+// the analytic ones of evaluateError
+template<class FACTOR>
+void timeJacobians(const FACTOR& factor, const Pose3& p1, const Vector3& v1,
+    const imuBias::ConstantBias& b1, const Pose3& p2, const Vector3& v2) {
+  ErrorFunction f = [&](const Pose3& a, const Vector3& b,
+      const imuBias::ConstantBias& c, const Pose3& d, const Vector3& e) {
+    return factor.evaluateError(a, b, c, d, e);
+  };
+
+  Matrix H1, H2, H3, H4, H5;
+  gttic_(NumericalJacobians);
+  for(size_t i = 0; i < 10000; ++i) {
+    H1 = numericalDerivative51<Vector, Pose3, Vector3, imuBias::ConstantBias, Pose3, Vector3>(f, p1, v1, b1, p2, v2);
+    H2 = numericalDerivative52<Vector, Pose3, Vector3, imuBias::ConstantBias, Pose3, Vector3>(f, p1, v1, b1, p2, v2);
+    H3 = numericalDerivative53<Vector, Pose3, Vector3, imuBias::ConstantBias, Pose3, Vector3>(f, p1, v1, b1, p2, v2);
+    H4 = numericalDerivative54<Vector, Pose3, Vector3, imuBias::ConstantBias, Pose3, Vector3>(f, p1, v1, b1, p2, v2);
+    H5 = numericalDerivative55<Vector, Pose3, Vector3, imuBias::ConstantBias, Pose3, Vector3>(f, p1, v1, b1, p2, v2);
+  }
+  gttoc_(NumericalJacobians);
+
+  gttic_(AnalyticJacobians);
+  for(size_t i = 0; i < 10000; ++i)
+    factor.evaluateError(p1, v1, b1, p2, v2, H1, H2, H3, H4, H5);
+  gttoc_(AnalyticJacobians);
+}
+
 #include <gtsam/linear/GaussianFactorGraph.h>
 /* ************************************************************************* */
 int main() {
@@ -102,6 +134,22 @@ int main() {
     graph.push_back(g);
   }
   gttoc_(LinearizeTiming);
+
+  timeJacobians(f, Pose1, Vel1, Bias1, Pose2, Vel2);
+  cout << "InertialNavFactor_GlobalVelocity" << endl;
+  tictoc_finishedIteration_();
+  tictoc_print_();
+  tictoc_reset_();
+
+  // Equivalent factor, from the same measurement pre-integrated once
+  Matrix Jacobian_wrt_t0_Overall = Matrix::Identity(15, 15);
+  EquivInertialNavFactor_GlobalVel<Pose3, Vector3, imuBias::ConstantBias> equiv(
+      PoseKey1, VelKey1, BiasKey1, PoseKey2, VelKey2,
+      measurement_dt * measurement_dt * measurement_acc / 2, measurement_dt * measurement_acc,
+      measurement_dt * measurement_gyro, measurement_dt, world_g, world_rho,
+      world_omega_earth, noiseModel::Isotropic::Sigma(9, 0.1), Jacobian_wrt_t0_Overall, Bias1);
+  timeJacobians(equiv, Pose1, Vel1, Bias1, Pose2, Vel2);
+  cout << "EquivInertialNavFactor_GlobalVel" << endl;
   tictoc_finishedIteration_();
   tictoc_print_();
 }
@@ -0,0 +1,120 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeInvDepthFactors.cpp
+ * @brief   Time linearization of the inverse-depth landmark factors, compared
+ *          to a GenericProjectionFactor on an XYZ landmark
+ */
+
+#include <gtsam_unstable/slam/InvDepthFactor3.h>
+#include <gtsam_unstable/slam/InvDepthFactorVariant1.h>
+#include <gtsam_unstable/slam/InvDepthFactorVariant2.h>
+#include <gtsam_unstable/slam/InvDepthFactorVariant3.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/base/timing.h>
+
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t n = 100000;
+
+/* ************************************************************************* */
+// Time linearization of a factor on the given values
+template<class FACTOR>
+void timeLinearize(const string& name, const FACTOR& factor, const Values& values) {
+  gttic_(linearize);
+  for (size_t i = 0; i < n; ++i)
+    factor.linearize(values);
+  gttoc_(linearize);
+
+  cout << name << endl;
+  tictoc_finishedIteration_();
+  tictoc_print_();
+  tictoc_reset_();
+}
+
+/* ************************************************************************* */
+int main() {
+  const Key poseKey1 = 1, poseKey2 = 2, landmarkKey = 100;
+  SharedNoiseModel model(noiseModel::Unit::Create(2));
+  Cal3_S2::shared_ptr K(new Cal3_S2(1500, 1200, 0, 640, 480));
+
+  // Two cameras looking in the x-direction, and a landmark 5 meters ahead
+  Pose3 pose1(Rot3::Ypr(-M_PI/2, 0., -M_PI/2), Point3(0, 0, 1.0));
+  Pose3 pose2(Rot3::Ypr(-M_PI/2, 0., -M_PI/2), Point3(0, 0, 1.5));
+  Point3 landmark(5, 0, 1);
+  Point2 pixel = PinholePose<Cal3_S2>(pose2, K).project(landmark);
+
+  // Same landmark in the various inverse-depth parameterizations
+  const Point3 ray = landmark - pose1.translation();
+  const double theta = atan2(ray.y(), ray.x()),
+      phi = atan2(ray.z(), sqrt(ray.x()*ray.x() + ray.y()*ray.y())),
+      rho = 1. / ray.norm();
+  const Point3 pose1_landmark = pose1.transformTo(landmark);
+  const Vector3 landmark3(
+      atan2(pose1_landmark.x(), pose1_landmark.z()),
+      atan2(pose1_landmark.y(), sqrt(pose1_landmark.x()*pose1_landmark.x() +
+                                     pose1_landmark.z()*pose1_landmark.z())),
+      1. / pose1_landmark.norm());
+  Vector5 landmark5;
+  landmark5 << pose1.translation(), theta, phi;
+  Vector6 landmark6;
+  landmark6 << pose1.translation(), theta, phi, rho;
+
+  {
+    Values values;
+    values.insert(poseKey2, pose2);
+    values.insert(landmarkKey, landmark);
+    timeLinearize("GenericProjectionFactor",
+        GenericProjectionFactor<Pose3, Point3, Cal3_S2>(pixel, model, poseKey2, landmarkKey, K),
+        values);
+  }
+  {
+    Values values;
+    values.insert(poseKey2, pose2);
+    values.insert(landmarkKey, landmark5);
+    values.insert(landmarkKey + 1, rho);
+    timeLinearize("InvDepthFactor3",
+        InvDepthFactor3<Pose3, Vector5, double>(pixel, model, poseKey2, landmarkKey, landmarkKey + 1, K),
+        values);
+  }
+  {
+    Values values;
+    values.insert(poseKey2, pose2);
+    values.insert(landmarkKey, landmark6);
+    timeLinearize("InvDepthFactorVariant1",
+        InvDepthFactorVariant1(poseKey2, landmarkKey, pixel, K, model), values);
+  }
+  {
+    Values values;
+    values.insert(poseKey2, pose2);
+    values.insert(landmarkKey, Vector3(theta, phi, rho));
+    timeLinearize("InvDepthFactorVariant2",
+        InvDepthFactorVariant2(poseKey2, landmarkKey, pixel, K, pose1.translation(), model),
+        values);
+  }
+  {
+    Values values;
+    values.insert(poseKey1, pose1);
+    values.insert(poseKey2, pose2);
+    values.insert(landmarkKey, landmark3);
+    timeLinearize("InvDepthFactorVariant3b",
+        InvDepthFactorVariant3b(poseKey1, poseKey2, landmarkKey, pixel, K, model),
+        values);
+  }
+  return 0;
+}
+
+/* ************************************************************************* */
@@ -152,6 +152,46 @@ TEST(DoglegOptimizer, Iterate) {
   }
 }
 
+/* ************************************************************************* */
+TEST(DoglegOptimizer, EvaluateStep) {
+  NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
+  Values config;
+  config.insert(X(1), Point2(3,0));
+
+  GaussianBayesNet gbn = *fg.linearize(config)->eliminateSequential();
+  VectorValues dx_u = gbn.optimizeGradientSearch();
+  VectorValues dx_n = gbn.optimize();
+  DoglegOptimizerImpl::TrialStep step = DoglegOptimizerImpl::EvaluateStep(0.5, dx_u, dx_n, gbn, fg, config);
+  VectorValues expected = DoglegOptimizerImpl::ComputeDoglegPoint(0.5, dx_u, dx_n);
+  DOUBLES_EQUAL(0.5, step.delta, 1e-9);
+  EXPECT(assert_equal(expected, step.dx_d));
+  DOUBLES_EQUAL(fg.error(config.retract(expected)), step.f_error, 1e-9);
+  DOUBLES_EQUAL(gbn.error(expected), step.M_error, 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(DoglegOptimizer, IterateDecreasingDelta) {
+  NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
+  Values config;
+  config.insert(X(1), Point2(2.8,0));
+
+  // Start with a much too large trust region, so it has to be decreased repeatedly,
+  // as the Newton step overshoots from here
+  const double Delta = 1e3;
+  GaussianBayesNet gbn = *fg.linearize(config)->eliminateSequential();
+  VectorValues dx_u = gbn.optimizeGradientSearch();
+  VectorValues dx_n = gbn.optimize();
+  for (DoglegOptimizerImpl::TrustRegionAdaptationMode mode :
+       {DoglegOptimizerImpl::SEARCH_EACH_ITERATION, DoglegOptimizerImpl::SEARCH_REDUCE_ONLY,
+        DoglegOptimizerImpl::ONE_STEP_PER_ITERATION}) {
+    DoglegOptimizerImpl::IterationResult result = DoglegOptimizerImpl::Iterate(
+        Delta, mode, dx_u, dx_n, gbn, fg, config, fg.error(config));
+    EXPECT(result.delta < Delta);
+    EXPECT(result.f_error < fg.error(config));
+    DOUBLES_EQUAL(fg.error(config.retract(result.dx_d)), result.f_error, 1e-9);
+  }
+}
+
 /* ************************************************************************* */
 TEST(DoglegOptimizer, Constraint) {
   // Create a pose-graph graph with a constraint on the first pose
@@ -399,6 +399,29 @@ TEST(GaussianFactorGraph, hasConstraints)
   EXPECT(!hasConstraints(fg));
 }
 
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, marginalMultifrontalBayesTrees)
+{
+  GaussianFactorGraph smoother = createSmoother(7);
+
+  // Single variables, variables in different cliques, and an unordered set
+  vector<KeyVector> variableSets;
+  variableSets.push_back(list_of<Key>(X(1)));
+  variableSets.push_back(list_of<Key>(X(2))(X(5)));
+  variableSets.push_back(list_of<Key>(X(7))(X(3))(X(4)));
+  variableSets.push_back(list_of<Key>(X(6)));
+
+  vector<GaussianBayesTree::shared_ptr> actual =
+      smoother.marginalMultifrontalBayesTrees(variableSets);
+  LONGS_EQUAL(4, actual.size());
+  for (size_t q = 0; q < variableSets.size(); q++) {
+    GaussianBayesTree expected = *smoother.marginalMultifrontalBayesTree(variableSets[q]);
+    Ordering ordering(variableSets[q]);
+    EXPECT(assert_equal(GaussianFactorGraph(expected).augmentedHessian(ordering),
+                        GaussianFactorGraph(*actual[q]).augmentedHessian(ordering), 1e-9));
+  }
+}
+
 #include <gtsam/slam/ProjectionFactor.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/sam/RangeFactor.h>
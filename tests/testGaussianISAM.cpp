@@ -70,6 +70,52 @@ TEST( ISAM, iSAM_smoother )
   EXPECT(assert_equal(e, optimized));
 }
 
+/* ************************************************************************* */
+TEST( ISAM, cachedShortcuts )
+{
+  GaussianFactorGraph smoother = createSmoother(7);
+  GaussianISAM isam;
+  isam.update(smoother);
+
+  // Cache shortcuts to a child of the root, and a marginal below it
+  GaussianBayesTree::sharedClique root = isam.roots().front();
+  CHECK(!root->children.empty());
+  GaussianBayesTree::sharedClique B = root->children.front();
+  CHECK(!B->children.empty());
+  GaussianBayesTree::sharedClique C = B->children.front();
+  const GaussianBayesNet expectedShortcut = C->shortcut(B);
+  const Key j = C->conditional()->front();
+  isam.marginalFactor(j);
+  EXPECT(C->cachedShortcut() && C->cachedShortcutRoot() == B);
+  EXPECT(C->cachedSeparatorMarginal());
+
+  // Update only the root: the subtree below B is orphaned and re-attached,
+  // keeping its shortcuts but not its separator marginals
+  GaussianFactorGraph newFactors;
+  newFactors += JacobianFactor(root->conditional()->front(), I_2x2, Vector2(1, 2),
+                               noiseModel::Isotropic::Sigma(2, 0.5));
+  isam.update(newFactors);
+  EXPECT(C->cachedShortcut() && C->cachedShortcutRoot() == B);
+  EXPECT(!C->cachedSeparatorMarginal());
+  EXPECT(assert_equal(expectedShortcut, C->shortcut(B)));
+
+  // Marginals use the new information
+  smoother += newFactors;
+  GaussianBayesTree expected = *smoother.eliminateMultifrontal();
+  EXPECT(assert_equal(*expected.marginalFactor(j), *isam.marginalFactor(j), 1e-9));
+
+  // Deleting the cached shortcuts clears them all
+  isam.deleteCachedShortcuts();
+  EXPECT(!C->cachedShortcut() && !C->cachedSeparatorMarginal());
+  EXPECT(assert_equal(expectedShortcut, C->shortcut(B)));
+
+  // ... also those below cliques without a cache, such as the root now
+  EXPECT(C->cachedShortcut() && !isam.roots().front()->cachedShortcut() &&
+         !isam.roots().front()->cachedSeparatorMarginal());
+  isam.deleteCachedShortcuts();
+  EXPECT(!C->cachedShortcut());
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
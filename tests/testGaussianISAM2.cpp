@@ -402,6 +402,51 @@ TEST(ISAM2, removeFactors)
   CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, compactFactors)
+{
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, ISAM2Params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false));
+  const size_t nrFactors = fullgraph.size();
+
+  // Remove two landmark measurements, leaving empty slots behind
+  FactorIndices toRemove;
+  toRemove.push_back(15);
+  toRemove.push_back(7);
+  isam.update(NonlinearFactorGraph(), Values(), toRemove);
+  fullgraph.remove(15);
+  fullgraph.remove(7);
+  EXPECT_LONGS_EQUAL(nrFactors, isam.getFactorsUnsafe().size());
+
+  // Compaction renumbers the remaining factors in order
+  FastMap<FactorIndex, FactorIndex> oldToNew = isam.compactFactors();
+  EXPECT_LONGS_EQUAL(nrFactors - 2, oldToNew.size());
+  EXPECT_LONGS_EQUAL(nrFactors - 2, isam.getFactorsUnsafe().size());
+  EXPECT_LONGS_EQUAL(nrFactors - 2, isam.getVariableIndex().nFactors());
+  EXPECT(oldToNew.find(7) == oldToNew.end());
+  EXPECT(oldToNew.find(15) == oldToNew.end());
+  EXPECT_LONGS_EQUAL(6, oldToNew[6]);
+  EXPECT_LONGS_EQUAL(7, oldToNew[8]);
+  EXPECT_LONGS_EQUAL(13, oldToNew[14]);
+
+  NonlinearFactorGraph compacted;
+  for (const auto& factor : fullgraph)
+    if (factor) compacted.push_back(factor);
+  EXPECT(assert_equal(compacted, isam.getFactorsUnsafe()));
+  EXPECT(assert_equal(VariableIndex(compacted), isam.getVariableIndex()));
+  CHECK(isam_check(compacted, fullinit, isam, *this, result_));
+
+  // Removing by a translated index keeps working afterwards, here the last
+  // measurement on landmark 0 (Key 100), which is removed with it
+  toRemove.clear();
+  toRemove.push_back(oldToNew[14]);
+  isam.update(NonlinearFactorGraph(), Values(), toRemove);
+  compacted.remove(oldToNew[14]);
+  fullinit.erase(100);
+  CHECK(isam_check(compacted, fullinit, isam, *this, result_));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, removeVariables)
 {
@@ -425,6 +470,291 @@ TEST(ISAM2, removeVariables)
   CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, choleskyUpdate)
+{
+  // These variables will be reused and accumulate factors and values
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false);
+  params.enableCholeskyUpdate = true;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  // A second odometry measurement between the last two poses, which are both
+  // in the root clique, is added by updating the root conditional
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(10, 11, Pose2(1.1, 0.1, 0.01), odoNoise);
+  fullgraph.push_back(newfactors);
+  ISAM2Result result = isam.update(newfactors);
+  EXPECT(result.updateType == ISAM2Result::CHOLESKY_UPDATE);
+  EXPECT_LONGS_EQUAL(0, result.variablesReeliminated);
+  EXPECT(isam_check(fullgraph, fullinit, isam, *this, result_));
+
+  // Removing it again downdates the root conditional
+  FactorIndices toRemove;
+  toRemove.push_back(result.newFactorsIndices.front());
+  result = isam.update(NonlinearFactorGraph(), Values(), toRemove);
+  fullgraph.remove(toRemove.front());
+  EXPECT(result.updateType == ISAM2Result::CHOLESKY_UPDATE);
+  EXPECT(isam_check(fullgraph, fullinit, isam, *this, result_));
+
+  // New variables require re-elimination
+  newfactors = NonlinearFactorGraph();
+  newfactors += BetweenFactor<Pose2>(11, 12, Pose2(1.0, 0.0, 0.0), odoNoise);
+  fullgraph.push_back(newfactors);
+  Values init;
+  init.insert(12, Pose2(7.9, 0.1, 0.01));
+  fullinit.insert(12, Pose2(7.9, 0.1, 0.01));
+  result = isam.update(newfactors, init);
+  EXPECT(result.updateType == ISAM2Result::INCREMENTAL_UPDATE);
+  EXPECT(isam_check(fullgraph, fullinit, isam, *this, result_));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, givensUpdate)
+{
+  // These variables will be reused and accumulate factors and values
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false);
+  params.enableCholeskyUpdate = true;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  // A measurement between two poses of a clique far from the root is rotated
+  // into that clique, and the remainder passed up to the root
+  const ISAM2::sharedClique clique = isam[3];
+  CHECK(clique->parent());
+  KeyVector poses;
+  for (Key key : *clique->conditional())
+    if (key < 100) poses.push_back(key);
+  CHECK(poses.size() >= 2);
+
+  // Cache a marginal, and shortcuts for a joint below the updated clique
+  ISAM2::sharedClique leaf = clique;
+  while (!leaf->children.empty()) leaf = leaf->children.front();
+  CHECK(leaf != clique);
+  const Key j = leaf->conditional()->front(), k = poses[0];
+  isam.marginalFactor(j);
+  isam.jointBayesNet(j, k);
+
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(poses[0], poses[1], Pose2(1.1, 0.1, 0.01), odoNoise);
+  fullgraph.push_back(newfactors);
+  ISAM2Result result = isam.update(newfactors);
+  EXPECT(result.updateType == ISAM2Result::CHOLESKY_UPDATE);
+  EXPECT(isam_check(fullgraph, fullinit, isam, *this, result_));
+
+  // The caches were computed from the old conditionals, and are not reused
+  const GaussianBayesTree expected =
+      *fullgraph.linearize(isam.getLinearizationPoint())->eliminateMultifrontal();
+  EXPECT(assert_equal(expected.marginalFactor(j)->information(),
+                      isam.marginalFactor(j)->information(), 1e-6));
+  const Ordering jk = list_of(j)(k);
+  const size_t n = isam.getLinearizationPoint().at(j).dim() +
+                   isam.getLinearizationPoint().at(k).dim();
+  EXPECT(assert_equal(
+      Matrix(GaussianFactorGraph(*expected.jointBayesNet(j, k)).augmentedHessian(jk).topLeftCorner(n, n)),
+      Matrix(GaussianFactorGraph(*isam.jointBayesNet(j, k)).augmentedHessian(jk).topLeftCorner(n, n)),
+      1e-6));
+
+  // Removing it again downdates the same cliques
+  FactorIndices toRemove;
+  toRemove.push_back(result.newFactorsIndices.front());
+  result = isam.update(NonlinearFactorGraph(), Values(), toRemove);
+  fullgraph.remove(toRemove.front());
+  EXPECT(result.updateType == ISAM2Result::CHOLESKY_UPDATE);
+  EXPECT(isam_check(fullgraph, fullinit, isam, *this, result_));
+
+  // A loop closure across the tree causes fill-in and needs re-elimination,
+  // which relies on the updated separator marginals of the cliques below
+  newfactors = NonlinearFactorGraph();
+  newfactors += BetweenFactor<Pose2>(1, 11, Pose2(10.0, 0.0, 0.0), odoNoise);
+  fullgraph.push_back(newfactors);
+  result = isam.update(newfactors);
+  EXPECT(result.updateType != ISAM2Result::CHOLESKY_UPDATE);
+  EXPECT(isam_check(fullgraph, fullinit, isam, *this, result_));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, recalculationCostModel)
+{
+  // These variables will be reused and accumulate factors and values
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false);
+  params.enableRecalculationCostModel = true;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  // Both strategies have been timed, so the next update is predicted
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(11, 12, Pose2(1.0, 0.0, 0.0), odoNoise);
+  fullgraph.push_back(newfactors);
+  Values init;
+  init.insert(12, Pose2(7.9, 0.1, 0.01));
+  fullinit.insert(12, Pose2(7.9, 0.1, 0.01));
+  ISAM2Result result = isam.update(newfactors, init);
+  CHECK(result.predictedBatchTime && result.predictedIncrementalTime);
+  EXPECT(*result.predictedBatchTime > 0.0);
+  EXPECT(*result.predictedIncrementalTime > 0.0);
+  EXPECT((result.updateType == ISAM2Result::BATCH_UPDATE) ==
+         (*result.predictedBatchTime < *result.predictedIncrementalTime));
+  EXPECT(isam_check(fullgraph, fullinit, isam, *this, result_));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, recalculationCostModelDecisions)
+{
+  // Calibrate with given rather than measured times: a batch step costs 1us
+  // and an incremental step 10us per unit of work
+  ISAM2CostModel model;
+  EXPECT(!model.calibrated());
+  model.measured(true, 1000.0, 1e-3);
+  EXPECT(!model.calibrated());
+  model.measured(false, 10.0, 1e-4);
+  EXPECT(model.calibrated());
+  EXPECT_DOUBLES_EQUAL(1e-6, *model.batchCost, 1e-15);
+  EXPECT_DOUBLES_EQUAL(1e-5, *model.incrementalCost, 1e-15);
+
+  // Extending a long chain only affects its end, so incremental is cheaper
+  ISAM2Result result;
+  EXPECT(!model.chooseBatch(1000.0, 10.0, &result));
+  EXPECT_DOUBLES_EQUAL(1e-3, *result.predictedBatchTime, 1e-12);
+  EXPECT_DOUBLES_EQUAL(1e-4, *result.predictedIncrementalTime, 1e-12);
+
+  // ... unless most of the chain is affected
+  EXPECT(model.chooseBatch(1000.0, 500.0, &result));
+
+  // Batch is measured again once 10% of the time spent on incremental steps
+  // since the last batch step would pay for it, that is after 100 steps
+  for (size_t i = 1; i < 99; ++i) model.measured(false, 10.0, 1e-4);
+  EXPECT(!model.chooseBatch(1000.0, 10.0, &result));
+  model.measured(false, 10.0, 1e-4);
+  model.measured(false, 10.0, 1e-4);
+  EXPECT(model.chooseBatch(1000.0, 10.0, &result));
+  EXPECT_DOUBLES_EQUAL(1e-5, *model.incrementalCost, 1e-15);
+
+  // A slow batch step is averaged in, and resets the time since batch
+  model.measured(true, 1000.0, 1e-2);
+  EXPECT_DOUBLES_EQUAL(0.7 * 1e-6 + 0.3 * 1e-5, *model.batchCost, 1e-15);
+  EXPECT_DOUBLES_EQUAL(0.0, model.batchIdleTime, 1e-15);
+  EXPECT(!model.chooseBatch(1000.0, 10.0, &result));
+
+  // The same holds the other way around
+  model.measured(false, 10.0, 1e-3);
+  EXPECT(model.chooseBatch(1000.0, 800.0, &result));
+  for (size_t i = 0; i < 100; ++i) model.measured(true, 1000.0, 3.7e-3);
+  EXPECT(!model.chooseBatch(1000.0, 800.0, &result));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, recalculationCostModelLongChain)
+{
+  // Once both strategies were measured, each update is predicted
+  ISAM2Params params;
+  params.enableRecalculationCostModel = true;
+  ISAM2 isam(params);
+  NonlinearFactorGraph prior;
+  prior.addPrior(0, Pose2(), odoNoise);
+  Values init;
+  init.insert(0, Pose2());
+  isam.update(prior, init);
+
+  const size_t nrPoses = 100, nrChecked = 50;
+  size_t predicted = 0;
+  for (size_t i = 0; i < nrPoses; ++i) {
+    NonlinearFactorGraph newfactors;
+    newfactors += BetweenFactor<Pose2>(i, i + 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values newvalues;
+    newvalues.insert(i + 1, Pose2(i + 1.0, 0.0, 0.0));
+    ISAM2Result result = isam.update(newfactors, newvalues);
+    if (i + nrChecked >= nrPoses && result.predictedBatchTime &&
+        result.predictedIncrementalTime)
+      ++predicted;
+  }
+  EXPECT_LONGS_EQUAL(nrChecked, predicted);
+  EXPECT(assert_equal(Pose2(nrPoses, 0.0, 0.0),
+                      isam.calculateEstimate<Pose2>(nrPoses), 1e-6));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, reorderStaleSubtree)
+{
+  // A chain eliminated with all even poses first leaves a tree whose ordering
+  // is stale: each odd pose ends up connected to many others
+  const size_t n = 20;
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  fullgraph.addPrior(0, Pose2(), odoNoise);
+  FastMap<Key, int> constrainedKeys;
+  int group = 0;
+  for (size_t i = 0; i < n; i += 2) constrainedKeys[i] = group++;
+  for (size_t i = 1; i < n; i += 2) constrainedKeys[i] = group++;
+  for (size_t i = 0; i < n; ++i) {
+    fullinit.insert(i, Pose2(1.01 * i, 0.01, 0.01));
+    if (i + 1 < n)
+      fullgraph += BetweenFactor<Pose2>(i, i + 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+  }
+  ISAM2 isam(ISAM2Params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false));
+  isam.update(fullgraph, fullinit, FactorIndices(), constrainedKeys);
+  const size_t nnzBefore = isam.roots().front()->calculate_nnz();
+
+  // The first call replaces a subtree and reduces fill-in
+  EXPECT(isam.reorderStaleSubtree(10) > 0);
+  EXPECT(isam.roots().front()->calculate_nnz() < nnzBefore);
+
+  // Maintain subtrees until all have been considered
+  for (size_t i = 0; i < 20; ++i)
+    isam.reorderStaleSubtree(10);
+  EXPECT_LONGS_EQUAL(0, isam.reorderStaleSubtree(10));
+
+  // The solution and gradients are unchanged
+  EXPECT(isam_check(fullgraph, fullinit, isam, *this, result_));
+
+  // Updates continue to work on the maintained tree
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(n - 1, n, Pose2(1.0, 0.0, 0.0), odoNoise);
+  newfactors += BetweenFactor<Pose2>(2, n, Pose2(18.0, 0.0, 0.0), odoNoise);
+  fullgraph.push_back(newfactors);
+  Values init;
+  init.insert(n, Pose2(19.9, 0.1, 0.01));
+  fullinit.insert(n, Pose2(19.9, 0.1, 0.01));
+  isam.update(newfactors, init);
+  EXPECT(isam_check(fullgraph, fullinit, isam, *this, result_));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, batchIngestion)
+{
+  // These variables will be reused and accumulate factors and values
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, ISAM2Params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false));
+
+  // Many loop closures at once are ingested with a single batch step
+  NonlinearFactorGraph newfactors;
+  for (size_t j = 0; j < 6; ++j)
+    newfactors += BetweenFactor<Pose2>(j, j + 5, Pose2(5.0, 0.0, 0.0), odoNoise);
+  fullgraph.push_back(newfactors);
+  ISAM2UpdateParams updateParams;
+  updateParams.batchIngestion = true;
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+  updateParams.batchOrderingType = Ordering::METIS;
+#endif
+  ISAM2Result result = isam.update(newfactors, Values(), updateParams);
+  EXPECT(result.updateType == ISAM2Result::BATCH_UPDATE);
+  EXPECT(isam_check(fullgraph, fullinit, isam, *this, result_));
+
+  // Regular updates continue from there
+  newfactors = NonlinearFactorGraph();
+  newfactors += BetweenFactor<Pose2>(11, 12, Pose2(1.0, 0.0, 0.0), odoNoise);
+  fullgraph.push_back(newfactors);
+  Values init;
+  init.insert(12, Pose2(7.9, 0.1, 0.01));
+  fullinit.insert(12, Pose2(7.9, 0.1, 0.01));
+  isam.update(newfactors, init);
+  EXPECT(isam_check(fullgraph, fullinit, isam, *this, result_));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, swapFactors)
 {
@@ -807,6 +1137,57 @@ TEST(ISAM2, marginalCovariance)
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, calculateEstimateCached)
+{
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, ISAM2Params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false), 4);
+
+  // First estimate fills the cache
+  Values expected = isam.getLinearizationPoint().retract(isam.getDelta());
+  EXPECT(assert_equal(expected, isam.calculateEstimate()));
+
+  // Change delta by adding more measurements, single-key estimates must agree
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(5, 6, Pose2(1.0, 0.0, 0.0), odoNoise);
+  newfactors += BetweenFactor<Pose2>(0, 6, Pose2(5.0, 0.0, 0.0), odoNoise);
+  Values init;
+  init.insert(6, Pose2(6.01, 0.01, 0.01));
+  isam.update(newfactors, init);
+
+  EXPECT(assert_equal(Pose2(isam.getLinearizationPoint().at<Pose2>(3).retract(isam.getDelta()[3])),
+                      isam.calculateEstimate<Pose2>(3)));
+  expected = isam.getLinearizationPoint().retract(isam.getDelta());
+  EXPECT(assert_equal(expected, isam.calculateEstimate()));
+  EXPECT(assert_equal(expected, isam.calculateEstimate()));
+  EXPECT(assert_equal(expected, isam.calculateBestEstimate()));
+
+  // The cached estimate is returned without copying
+  EXPECT(&isam.calculateEstimate() == &isam.calculateBestEstimate());
+
+  // Only the variables changed by relinearization and the wildfire are
+  // recomputed, check that no other estimate goes stale over a few steps
+  for (size_t i = 7; i < 10; ++i) {
+    NonlinearFactorGraph odometry;
+    odometry += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values newPose;
+    newPose.insert(i, Pose2(double(i) + 0.01, 0.01, 0.01));
+    isam.update(odometry, newPose);
+    EXPECT(assert_equal(isam.getLinearizationPoint().at<Pose2>(i - 1).retract(
+                            isam.getDelta()[i - 1]),
+                        isam.calculateEstimate<Pose2>(i - 1)));
+    expected = isam.getLinearizationPoint().retract(isam.getDelta());
+    EXPECT(assert_equal(expected, isam.calculateEstimate()));
+  }
+
+  // Marginalized variables leave the estimate
+  isam.marginalizeLeaves(FastList<Key>(1, 9));
+  EXPECT(!isam.calculateEstimate().exists(9));
+  expected = isam.getLinearizationPoint().retract(isam.getDelta());
+  EXPECT(assert_equal(expected, isam.calculateEstimate()));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, calculate_nnz)
 {
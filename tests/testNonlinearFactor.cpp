@@ -233,6 +233,34 @@ TEST( NonlinearFactor, linearize_constraint2 )
   CHECK(assert_equal((const GaussianFactor&)expected, *actual));
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactor, gradientAtZero )
+{
+  Point2 z3(1.,-1.);
+  Values config;
+  config.insert(X(1), Point2(1.0, 2.0));
+  config.insert(L(1), Point2(5.0, 4.0));
+
+  // Diagonal, constrained and robust noise models all whiten differently
+  const SharedNoiseModel models[] = {
+    noiseModel::Isotropic::Sigma(2, 0.5),
+    noiseModel::Constrained::MixedSigmas(Vector2(0.2,0)),
+    noiseModel::Robust::Create(noiseModel::mEstimator::Huber::Create(1.0),
+                               noiseModel::Isotropic::Sigma(2, 0.5))};
+  for (const SharedNoiseModel& model : models) {
+    simulated2D::Measurement f0(z3, model, X(1), L(1));
+    VectorValues expected = f0.linearize(config)->gradientAtZero();
+    VectorValues actual = config.zeroVectors();
+    f0.gradientAtZero(config, actual);
+    EXPECT(assert_equal(expected, actual));
+
+    // Base class version linearizes, and has to agree
+    VectorValues viaLinearize = config.zeroVectors();
+    f0.NonlinearFactor::gradientAtZero(config, viaLinearize);
+    EXPECT(assert_equal(expected, viaLinearize));
+  }
+}
+
 /* ************************************************************************* */
 class TestFactor4 : public NoiseModelFactor4<double, double, double, double> {
 public:
@@ -116,6 +116,22 @@ TEST( NonlinearFactorGraph, linearize )
   CHECK(assert_equal(expected,linearFG)); // Needs correct linearizations
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, gradientAtZero )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  fg.push_back(NonlinearFactorGraph::sharedFactor()); // null factors are skipped
+  Values initial = createNoisyValues();
+  VectorValues expected = fg.linearize(initial)->gradientAtZero();
+  EXPECT(assert_equal(expected, fg.gradientAtZero(initial)));
+
+  // Accumulate into pre-allocated gradient, previous contents are discarded
+  VectorValues actual = initial.zeroVectors();
+  actual.at(X(1)).setConstant(1.0);
+  fg.gradientAtZero(initial, actual);
+  EXPECT(assert_equal(expected, actual));
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, clone )
 {
@@ -19,6 +19,7 @@
 #include "timeLinearize.h"
 #include <gtsam/3rdparty/ceres/example.h>
 #include <gtsam/nonlinear/AdaptAutoDiff.h>
+#include <gtsam/nonlinear/AutoDiffFactorBatch.h>
 #include <gtsam/nonlinear/ExpressionFactor.h>
 #include <gtsam/slam/GeneralSFMFactor.h>
 #include <gtsam/geometry/PinholeCamera.h>
@@ -71,5 +72,16 @@ int main() {
   f2 = boost::make_shared<ExpressionFactor<Vector2> >(model, z, expression);
   time("Point2_(AdaptedSnavely(), camera, point): ", f2, values);
 
+  // AdaptAutoDiff, n factors linearized at once in SIMD lanes
+  AutoDiffFactorBatch<SnavelyProjection, 2, 9, 3> batch(model);
+  for (int i = 0; i < n; i++)
+    batch.add(1, 2, z);
+  long timeLog = clock();
+  GaussianFactorGraph gfg = batch.linearizeFactors(values);
+  long timeLog2 = clock();
+  double seconds = (double) (timeLog2 - timeLog) / CLOCKS_PER_SEC;
+  cout << "AutoDiffFactorBatch<SnavelyProjection>  : "
+      << ((double) seconds * 1000000 / n) << " musecs/call" << endl;
+
   return 0;
 }
@@ -0,0 +1,85 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeBetweenFactorBlock.cpp
+ * @brief   Time linearization of a Pose3 pose graph, with separate
+ *          BetweenFactors and with one BetweenFactorBlock
+ */
+
+#include <gtsam/slam/BetweenFactorBlock.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/base/timing.h>
+
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t n = 100000;
+static const size_t iterations = 10;
+
+int main() {
+  // Random walk with odometry between consecutive poses, and a loop closure
+  // to a pose 100 steps back at every 10th pose
+  Matrix6 information = Matrix6::Random();
+  information = information.transpose() * information + 10 * Matrix6::Identity();
+  SharedNoiseModel model = noiseModel::Gaussian::Information(information);
+
+  Values values;
+  NonlinearFactorGraph separate, blocked;
+  BetweenFactorBlock<Pose3>::shared_ptr block =
+      boost::make_shared<BetweenFactorBlock<Pose3> >();
+  Pose3 pose;
+  for (size_t i = 0; i < n; ++i) {
+    values.insert(i, pose);
+    pose = pose.retract(0.1 * Vector6::Random());
+  }
+  auto addEdge = [&](size_t j, size_t i) {
+    const Pose3 measured = values.at<Pose3>(j).between(values.at<Pose3>(i));
+    separate.emplace_shared<BetweenFactor<Pose3> >(j, i, measured, model);
+    block->add(j, i, measured, model);
+  };
+  for (size_t i = 1; i < n; ++i) {
+    addEdge(i - 1, i);
+    if (i >= 100 && i % 10 == 0)
+      addEdge(i - 100, i);
+  }
+  blocked.push_back(block);
+  cout << "Pose graph with " << n << " poses and " << separate.size()
+       << " BetweenFactors" << endl;
+
+  gttic_(separate);
+  for (size_t i = 0; i < iterations; ++i)
+    separate.linearize(values);
+  gttoc_(separate);
+
+  gttic_(block);
+  for (size_t i = 0; i < iterations; ++i)
+    blocked.linearizeExpanded(values);
+  gttoc_(block);
+
+  gttic_(separate_error);
+  for (size_t i = 0; i < iterations; ++i)
+    separate.error(values);
+  gttoc_(separate_error);
+
+  gttic_(block_error);
+  for (size_t i = 0; i < iterations; ++i)
+    blocked.error(values);
+  gttoc_(block_error);
+
+  tictoc_finishedIteration_();
+  tictoc_print_();
+  return 0;
+}
@@ -0,0 +1,79 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeChainCompression.cpp
+ * @brief   Time optimizing a dense Pose3 trajectory, with and without
+ *          compressing the odometry chains between keyframes
+ */
+
+#include <gtsam/slam/ChainCompression.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/base/timing.h>
+
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t n = 20000;
+static const size_t keyframeInterval = 20;
+
+int main() {
+  // Random walk with noisy odometry, and loop closures between keyframes
+  SharedNoiseModel model = noiseModel::Diagonal::Sigmas(
+      (Vector(6) << 0.01, 0.01, 0.01, 0.05, 0.05, 0.05).finished());
+  NonlinearFactorGraph graph;
+  Values truth, initial;
+  Pose3 pose;
+  for (size_t i = 0; i < n; ++i) {
+    truth.insert(i, pose);
+    pose = pose.retract(0.1 * Vector6::Random());
+  }
+  graph.addPrior(0, truth.at<Pose3>(0), model);
+  initial.insert(0, truth.at<Pose3>(0));
+  for (size_t i = 1; i < n; ++i) {
+    const Pose3 odometry = truth.at<Pose3>(i - 1).between(truth.at<Pose3>(i))
+        .retract(0.01 * Vector6::Random());
+    graph.emplace_shared<BetweenFactor<Pose3> >(i - 1, i, odometry, model);
+    initial.insert(i, initial.at<Pose3>(i - 1) * odometry);
+  }
+  KeySet removable;
+  for (size_t i = 0; i < n; ++i) {
+    if (i % keyframeInterval != 0) {
+      removable.insert(i);
+    } else if (i >= 10 * keyframeInterval) {
+      const size_t j = i - 10 * keyframeInterval;
+      graph.emplace_shared<BetweenFactor<Pose3> >(j, i,
+          truth.at<Pose3>(j).between(truth.at<Pose3>(i)), model);
+    }
+  }
+
+  gttic_(full);
+  Values full = LevenbergMarquardtOptimizer(graph, initial).optimize();
+  gttoc_(full);
+
+  gttic_(compressed);
+  ChainCompression<Pose3> compression(graph, removable);
+  Values reduced = LevenbergMarquardtOptimizer(compression.graph(),
+      compression.reduce(initial)).optimize();
+  Values expanded = compression.expand(reduced);
+  gttoc_(compressed);
+
+  cout << graph.size() << " factors, " << compression.graph().size()
+       << " after compression" << endl;
+  cout << "error: full " << graph.error(full) << ", compressed and expanded "
+       << graph.error(expanded) << endl;
+  tictoc_finishedIteration_();
+  tictoc_print_();
+  return 0;
+}
@@ -0,0 +1,60 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeNoiseModel.cpp
+ * @brief   Time whitening with a full-covariance Gaussian noise model, as used
+ *          by BetweenFactor<Pose3> on g2o datasets
+ */
+
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/base/timing.h>
+
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t n = 1000000;
+
+int main() {
+  // Information matrix of a Pose3 edge with correlated rotation/translation
+  Matrix6 information = Matrix6::Random();
+  information = information.transpose() * information + 10 * Matrix6::Identity();
+  noiseModel::Gaussian::shared_ptr model =
+      noiseModel::Gaussian::Information(information);
+  const Matrix R = model->R();
+
+  Matrix A1 = Matrix::Random(6, 6), A2 = Matrix::Random(6, 6);
+  Vector b = Vector::Random(6);
+
+  // Dynamic matrix products, as done before
+  gttic_(dynamic);
+  for (size_t i = 0; i < n; ++i) {
+    A1 = R * A1;
+    A2 = R * A2;
+    b = R * b;
+    A1 *= 1e-3; A2 *= 1e-3; b *= 1e-3;  // keep the numbers bounded
+  }
+  gttoc_(dynamic);
+
+  // Fixed-size kernels
+  gttic_(WhitenSystem);
+  for (size_t i = 0; i < n; ++i) {
+    model->WhitenSystem(A1, A2, b);
+    A1 *= 1e-3; A2 *= 1e-3; b *= 1e-3;
+  }
+  gttoc_(WhitenSystem);
+
+  tictoc_finishedIteration_();
+  tictoc_print_();
+  return 0;
+}
@@ -19,6 +19,7 @@
 #include <iostream>
 
 #include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/PinholePose.h>
 #include <gtsam/geometry/Cal3Bundler.h>
 
 using namespace std;
@@ -110,5 +111,27 @@ int main()
     cout << ((double)seconds*1e9/n) << " nanosecs/call" << endl;
   }
 
+  // Value-only project2, and with fixed-size derivatives, on a PinholePose
+  {
+    const PinholePose<Cal3Bundler> pinhole(pose1, boost::make_shared<Cal3Bundler>(K));
+    Point2 sum(0, 0);
+    long timeLog = clock();
+    for(int i = 0; i < n; i++)
+      sum += pinhole.project2(point1);
+    long timeLog2 = clock();
+    double seconds = (double)(timeLog2-timeLog)/CLOCKS_PER_SEC;
+    cout << ((double)seconds*1e9/n) << " nanosecs/call" << endl;
+
+    Matrix26 Dpose;
+    Matrix23 Dpoint;
+    timeLog = clock();
+    for(int i = 0; i < n; i++)
+      sum += pinhole.project2(point1, Dpose, Dpoint);
+    timeLog2 = clock();
+    seconds = (double)(timeLog2-timeLog)/CLOCKS_PER_SEC;
+    cout << ((double)seconds*1e9/n) << " nanosecs/call" << endl;
+    cout << sum.transpose() << endl; // keep the value-only calls alive
+  }
+
   return 0;
 }
@@ -40,6 +40,9 @@ int main()
   Vector v = (Vector(6) << x, y, z, 0.1, 0.2, -0.1).finished();
   Pose3 T = Pose3::Expmap((Vector(6) << 0.1, 0.1, 0.2, 0.1, 0.4, 0.2).finished()), T2 = T.retract(v);
   Matrix H1,H2;
+  Matrix36 D_pose;
+  Matrix3 D_point;
+  Point3 p(0.3, -0.2, 1.5), sum(0, 0, 0);
 
   TEST(retract, T.retract(v))
   TEST(Expmap, T*Pose3::Expmap(v))
@@ -47,9 +50,15 @@ int main()
   TEST(between, T.between(T2))
   TEST(between_derivatives, T.between(T2,H1,H2))
   TEST(Logmap, Pose3::Logmap(T.between(T2)))
+  TEST(compose, T2 = T2.compose(T))
+  TEST(transformFrom, sum += T.transformFrom(p))
+  TEST(transformFrom_derivatives, sum += T.transformFrom(p, D_pose, D_point))
+  TEST(transformTo, sum += T.transformTo(p))
+  TEST(transformTo_derivatives, sum += T.transformTo(p, D_pose, D_point))
 
   // Print timings
   tictoc_print_();
+  cout << sum.transpose() << endl; // keep the value-only calls alive
 
   return 0;
 }
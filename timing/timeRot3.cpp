@@ -41,6 +41,8 @@ int main() {
   double x = 1.0 / norm, y = 4.0 / norm, z = 2.0 / norm;
   Vector v = (Vector(3) << x, y, z).finished();
   Rot3 R = Rot3::Rodrigues(0.1, 0.4, 0.2), R2 = R.retract(v);
+  Point3 p(0.3, -0.2, 1.5), sum(0, 0, 0);
+  Matrix3 H1, H2;
 
   TEST("Rodriguez formula given axis angle", Rot3::AxisAngle(v, 0.001))
   TEST("Rodriguez formula given canonical coordinates", Rot3::Rodrigues(v))
@@ -50,6 +52,12 @@ int main() {
   TEST("localCoordinates", R.localCoordinates(R2))
   TEST("Slow rotation matrix", Rot3::Rz(z) * Rot3::Ry(y) * Rot3::Rx(x))
   TEST("Fast Rotation matrix", Rot3::RzRyRx(x, y, z))
+  TEST("compose", R2 = R2 * R)
+  TEST("rotate", sum += R.rotate(p))
+  TEST("rotate with derivatives", sum += R.rotate(p, H1, H2))
+  TEST("unrotate", sum += R.unrotate(p))
+  TEST("unrotate with derivatives", sum += R.unrotate(p, H1, H2))
+  cout << sum.transpose() << endl;  // keep the value-only calls alive
 
   return 0;
 }